@@ -0,0 +1,185 @@
+// BENCHMARK DEL COSTO DE ADMISIÓN ORDENADA POR AUTO
+//
+// Compara el turno original (turnoMutex + turnoCond + pthread_cond_broadcast) con el
+// secuenciador por casillas de Comun/secuenciador.h. Para cada cantidad de autos crea
+// un hilo por auto, espera a que todos estén bloqueados esperando su turno y mide
+// cuánto tarda en admitirse la fila completa. Con broadcast el costo por auto crece
+// con N (cada avance despierta a todos); con el secuenciador cada avance despierta a
+// un solo auto, pero el costo por auto no es constante: con miles de hilos dormidos
+// las esperas del futex comparten las cubetas de la tabla hash del kernel (unas 256
+// por CPU), así que cada despertar recorre más esperas ajenas, y el hilo que despierta
+// ya no está en la caché. Por eso con 10000 autos sube aunque siga muy lejos del
+// broadcast.
+//
+// Compilar: gcc -O2 -pthread benchmarkAdmision.c -o benchmarkAdmision
+// Uso:      ./benchmarkAdmision [maxAutos] [maxAutosBroadcast]
+//           (por defecto 100000 y 10000; el broadcast es O(N²) y tarda mucho más)
+//
+// Nota: con 100k autos hacen falta 100k hilos (con pilas de PTHREAD_STACK_MIN), así
+// que puede ser necesario subir "ulimit -u", /proc/sys/kernel/threads-max y
+// /proc/sys/kernel/pid_max. Si no se pueden crear más hilos el benchmark lo avisa y se
+// detiene en esa cantidad.
+
+#define _XOPEN_SOURCE 600
+#include <limits.h>  // Para PTHREAD_STACK_MIN
+#include <pthread.h> // Para hilos, mutex y condicionales
+#include <stdio.h>   // Para printf
+#include <stdlib.h>  // Para atoi, malloc, free
+#include <time.h>    // Para clock_gettime
+#include <unistd.h>  // Para usleep
+#include "../Comun/secuenciador.h"
+
+// -------- ESTADO COMPARTIDO DE UNA CORRIDA ----------
+int nAutos = 0;
+atomic_int autosListos;      // Autos que ya llegaron a esperar su turno
+struct timespec finAdmision; // Momento en que se admitió al último auto
+
+// Versión con secuenciador
+Secuenciador secuenciador;
+
+// Versión original con broadcast
+pthread_mutex_t turnoMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  turnoCond  = PTHREAD_COND_INITIALIZER;
+int turnoAuto = 1;           // -1 = corrida cancelada: todos salen sin esperar su turno
+
+double segundosEntre(struct timespec a, struct timespec b) {
+  return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+// El auto 1 es el propio main (abre la fila); los autos del benchmark son 2..nAutos+1
+void* autoSecuenciador(void* arg) {
+  int indiceAuto = (int)(long)arg;
+  atomic_fetch_add(&autosListos, 1);
+  secuenciadorEsperar(&secuenciador, indiceAuto);
+  secuenciadorAvanzar(&secuenciador, indiceAuto);
+  if (indiceAuto == nAutos + 1) {
+    clock_gettime(CLOCK_MONOTONIC, &finAdmision);
+  }
+  return NULL;
+}
+
+void* autoBroadcast(void* arg) {
+  int indiceAuto = (int)(long)arg;
+  pthread_mutex_lock(&turnoMutex);
+  atomic_fetch_add(&autosListos, 1);
+  while (indiceAuto != turnoAuto && turnoAuto != -1) {
+    pthread_cond_wait(&turnoCond, &turnoMutex);
+  }
+  if (turnoAuto != -1) {
+    turnoAuto++;
+  }
+  pthread_cond_broadcast(&turnoCond);
+  pthread_mutex_unlock(&turnoMutex);
+  if (indiceAuto == nAutos + 1) {
+    clock_gettime(CLOCK_MONOTONIC, &finAdmision);
+  }
+  return NULL;
+}
+
+/* ---------------------------------------------------------
+Corre una admisión completa de n autos. Devuelve los
+nanosegundos por auto, o -1 si no se pudieron crear los hilos.
+------------------------------------------------------------*/
+double correr(int n, int usarSecuenciador) {
+  nAutos = n;
+  atomic_store(&autosListos, 0);
+  turnoAuto = 0; // Nadie avanza hasta que main abra la fila
+  if (usarSecuenciador && secuenciadorIniciar(&secuenciador, n + 1) != 0) {
+    return -1;
+  }
+  if (usarSecuenciador) {
+    atomic_store(&secuenciador.casillas[0], TURNO_NO);
+  }
+
+  // Pilas chicas: los hilos no hacen casi nada y así caben muchos más
+  pthread_attr_t atributos;
+  pthread_attr_init(&atributos);
+  pthread_attr_setstacksize(&atributos, PTHREAD_STACK_MIN);
+
+  pthread_t* hilos = malloc(sizeof(pthread_t) * n);
+  int creados = 0;
+  // Se crean al revés para que todos tengan que esperar a los anteriores
+  for (int i = n; i >= 1 && hilos; i--) {
+    if (pthread_create(&hilos[creados], &atributos, usarSecuenciador ? autoSecuenciador : autoBroadcast,
+                       (void*)(long)(i + 1)) != 0) {
+      break;
+    }
+    creados++;
+  }
+  pthread_attr_destroy(&atributos);
+
+  double nsPorAuto = -1;
+  if (creados == n) {
+    // Espero a que todos estén esperando y les doy un momento para bloquearse
+    while (atomic_load(&autosListos) < n) {
+      usleep(1000);
+    }
+    usleep(100000);
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    if (usarSecuenciador) {
+      atomic_store(&secuenciador.casillas[0], TURNO_SI);
+      secuenciadorAvanzar(&secuenciador, 1);
+    } else {
+      pthread_mutex_lock(&turnoMutex);
+      turnoAuto = 2;
+      pthread_cond_broadcast(&turnoCond);
+      pthread_mutex_unlock(&turnoMutex);
+    }
+    for (int i = 0; i < creados; i++) {
+      pthread_join(hilos[i], NULL);
+    }
+    nsPorAuto = segundosEntre(inicio, finAdmision) * 1e9 / n;
+  } else {
+    // No se pudieron crear todos: libero a los que sí se crearon y aviso
+    fprintf(stderr, "Solo se pudieron crear %d de %d hilos (revisar ulimit -u)\n", creados, n);
+    if (usarSecuenciador) {
+      for (int i = 0; i <= n; i++) {
+        atomic_store(&secuenciador.casillas[i], TURNO_SI);
+        futexDespertar(&secuenciador.casillas[i], 1);
+      }
+    } else {
+      pthread_mutex_lock(&turnoMutex);
+      turnoAuto = -1;
+      pthread_cond_broadcast(&turnoCond);
+      pthread_mutex_unlock(&turnoMutex);
+    }
+    for (int i = 0; i < creados; i++) {
+      pthread_join(hilos[i], NULL);
+    }
+  }
+
+  free(hilos);
+  if (usarSecuenciador) {
+    secuenciadorDestruir(&secuenciador);
+  }
+  return nsPorAuto;
+}
+
+int main(int argc, char const* argv[]) {
+  int maxAutos = argc > 1 ? atoi(argv[1]) : 100000;
+  int maxBroadcast = argc > 2 ? atoi(argv[2]) : 10000;
+
+  printf("%-10s%-25s%-25s\n", "Autos", "Secuenciador (ns/auto)", "Broadcast (ns/auto)");
+  printf("------------------------------------------------------------\n");
+  for (int n = 10; n <= maxAutos; n *= 10) {
+    double secuenciado = correr(n, 1);
+    if (secuenciado < 0) {
+      break;
+    }
+    printf("%-10d%-25.0f", n, secuenciado);
+    if (n <= maxBroadcast) {
+      double difundido = correr(n, 0);
+      if (difundido < 0) {
+        printf("\n");
+        break;
+      }
+      printf("%-25.0f\n", difundido);
+    } else {
+      printf("%-25s\n", "(omitido)");
+    }
+    fflush(stdout);
+  }
+  return EXIT_SUCCESS;
+}
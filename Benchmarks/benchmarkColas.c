@@ -0,0 +1,162 @@
+// BENCHMARK DE LAS COLAS POR ESTACIÓN CONTRA LAS VARIANTES DE ESPERA COMPARTIDA
+//
+// Corre las estrategias del motor que esperan en una primitiva compartida (semáforos
+// con traspaso, variable de condición global y espera con futex) y la de colas por
+// estación (Motor/estrategiaColas.h) con los mismos autos: cada hilo entra, trabaja
+// un rato corto y sale, una y otra vez, con más hilos que plazas libres para que
+// siempre haya autos esperando. Mide cuánto cuesta cada entrada+salida y cuántos
+// cambios de contexto hubo (getrusage).
+//
+// Escenarios:
+//   pareja   64 estaciones de 1 plaza
+//   sesgada  1 estación de 32 plazas y 63 de 1 (casi toda la capacidad en una)
+//   100k     100000 estaciones de 1 plaza con todas menos 64 ya ocupadas: el centro
+//            casi lleno de los escenarios grandes, donde recorrer todas las estaciones
+//            por cada auto que espera es lo que más cuesta
+//
+// Compilar: gcc -O2 -pthread benchmarkColas.c -o benchmarkColas -lm
+// Uso:      ./benchmarkColas [hilos] [vueltas] [trabajoMicrosegundos]
+//           (por defecto 128 hilos, 200 vueltas por hilo y 20 µs de trabajo)
+//
+// Nota: la contención sobre las primitivas compartidas solo se ve con varios núcleos;
+// con uno solo los hilos se turnan y lo que queda a la vista es el costo de recorrer
+// las estaciones.
+
+#define _XOPEN_SOURCE 600
+#include <pthread.h>      // Para hilos y la barrera de largada
+#include <stdio.h>        // Para printf
+#include <stdlib.h>       // Para atoi, malloc, free
+#include <sys/resource.h> // Para getrusage (cambios de contexto)
+#include <time.h>         // Para clock_gettime
+#include "../Comun/registro.h"
+#include "../Comun/escenario.h"
+#include "../Motor/estrategiaSemaforos.h"
+#include "../Motor/estrategiaCondicion.h"
+#include "../Motor/estrategiaEspera.h"
+#include "../Motor/estrategiaColas.h"
+
+static const Estrategia* const variantes[] = {
+  &estrategiaSemaforos, &estrategiaCondicion, &estrategiaEspera, &estrategiaColas,
+};
+#define N_VARIANTES (int)(sizeof(variantes) / sizeof(variantes[0]))
+
+// -------- ESTADO COMPARTIDO DE UNA CORRIDA ----------
+const Estrategia* estrategia;
+int hilos, vueltas, nOcupados;
+uint64_t trabajoNs;
+pthread_barrier_t largada;
+
+// El registro no imprime nada: la traza va a /dev/null
+pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+char* tareas[] = {"TRABAJO"};
+const char* formatosEvento[N_TIPOS_EVENTO] = {"", "", "", "", ""};
+
+double segundosEntre(struct timespec a, struct timespec b) {
+  return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+long cambiosDeContexto(void) {
+  struct rusage uso;
+  getrusage(RUSAGE_SELF, &uso);
+  return uso.ru_nvcsw + uso.ru_nivcsw;
+}
+
+// Cada hilo es una seguidilla de autos (números propios, después de los ya ocupados)
+void* autoRoutine(void* arg) {
+  int hilo = *(int*)arg;
+  pthread_barrier_wait(&largada);
+  for (int v = 0; v < vueltas; v++) {
+    int indiceAuto = nOcupados + hilo * vueltas + v + 1;
+    int estacion = estrategia->entrar(indiceAuto);
+    dormirNs(trabajoNs);
+    estrategia->salir(estacion);
+  }
+  return NULL;
+}
+
+/* ---------------------------------------------------------
+Corre una variante en el escenario: ocupa "nOcupados" plazas
+desde main, larga los hilos, espera a que terminen y devuelve
+los nanosegundos por entrada+salida (y los cambios de contexto
+en *cambios).
+------------------------------------------------------------*/
+double correr(const Estrategia* e, Escenario* escenario, long* cambios) {
+  estrategia = e;
+  int nAutos = nOcupados + hilos * vueltas;
+  if (e->iniciar(escenario, nAutos, POLITICA_PRIMERA) != 0) {
+    return -1;
+  }
+  int* ocupadas = malloc(sizeof(int) * (nOcupados > 0 ? nOcupados : 1));
+  for (int i = 0; i < nOcupados; i++) {
+    ocupadas[i] = e->entrar(i + 1);
+  }
+
+  pthread_t* h = malloc(sizeof(pthread_t) * hilos);
+  int* numeros = malloc(sizeof(int) * hilos);
+  pthread_barrier_init(&largada, NULL, hilos + 1);
+  for (int i = 0; i < hilos; i++) {
+    numeros[i] = i;
+    pthread_create(&h[i], NULL, autoRoutine, &numeros[i]);
+  }
+  long cambiosAntes = cambiosDeContexto();
+  struct timespec inicio, fin;
+  clock_gettime(CLOCK_MONOTONIC, &inicio);
+  pthread_barrier_wait(&largada);
+  for (int i = 0; i < hilos; i++) {
+    pthread_join(h[i], NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &fin);
+  *cambios = cambiosDeContexto() - cambiosAntes;
+
+  for (int i = 0; i < nOcupados; i++) {
+    e->salir(ocupadas[i]);
+  }
+  e->destruir();
+  pthread_barrier_destroy(&largada);
+  free(ocupadas);
+  free(numeros);
+  free(h);
+  return segundosEntre(inicio, fin) * 1e9 / ((double)hilos * vueltas);
+}
+
+int main(int argc, char const* argv[]) {
+  hilos = argc > 1 ? atoi(argv[1]) : 128;
+  vueltas = argc > 2 ? atoi(argv[2]) : 200;
+  trabajoNs = (uint64_t)(argc > 3 ? atoi(argv[3]) : 20) * 1000;
+  if (hilos < 1 || vueltas < 1) {
+    fprintf(stderr, "Uso: %s [hilos] [vueltas] [trabajoMicrosegundos]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (registroIniciar(formatosEvento, tareas, 1, &mutex, 0, "/dev/null", 0) != 0) {
+    perror("No se pudo abrir /dev/null para la traza\n");
+    return EXIT_FAILURE;
+  }
+
+  const char* nombres[] = {"pareja", "sesgada", "100k"};
+  int estacionesPorEscenario[] = {64, 64, 100000};
+  printf("%d hilos, %d vueltas por hilo, %llu µs de trabajo\n", hilos, vueltas,
+         (unsigned long long)(trabajoNs / 1000));
+  printf("%-8s %-10s %14s %12s\n", "Escenario", "Estrategia", "ns por auto", "Cambios ctx");
+  for (int s = 0; s < 3; s++) {
+    Escenario escenario = {0};
+    escenario.nEstaciones = estacionesPorEscenario[s];
+    escenario.capacidades = malloc(sizeof(int) * escenario.nEstaciones);
+    for (int i = 0; i < escenario.nEstaciones; i++) {
+      escenario.capacidades[i] = s == 1 && i == 0 ? 32 : 1;
+      escenario.plazasTotales += escenario.capacidades[i];
+    }
+    nOcupados = s == 2 ? escenario.nEstaciones - 64 : 0;
+    for (int v = 0; v < N_VARIANTES; v++) {
+      long cambios;
+      double ns = correr(variantes[v], &escenario, &cambios);
+      if (ns < 0) {
+        perror("No se pudo reservar memoria para la estrategia\n");
+        return EXIT_FAILURE;
+      }
+      printf("%-9s %-10s %14.0f %12ld\n", nombres[s], variantes[v]->nombre, ns, cambios);
+    }
+    free(escenario.capacidades);
+  }
+  registroTerminar();
+  return EXIT_SUCCESS;
+}
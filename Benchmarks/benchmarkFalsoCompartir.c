@@ -0,0 +1,159 @@
+// BENCHMARK DE FALSO COMPARTIR EN LAS PLAZAS DE LAS ESTACIONES
+//
+// Compara el estado por estación compacto de antes (atomic_int[] y sem_t[], varias
+// estaciones por línea de caché) con el alineado de Comun/lineaCache.h (una estación
+// por línea). Cada hilo toma y devuelve plazas una y otra vez en SU estación: no
+// comparten ningún dato, así que lo ideal es que las operaciones por segundo crezcan
+// con la cantidad de hilos. Con el array compacto las estaciones vecinas se pelean la
+// misma línea y el total se estanca (o cae) en cuanto hay más de un núcleo.
+//
+// Compilar: gcc -O2 -pthread benchmarkFalsoCompartir.c -o benchmarkFalsoCompartir
+// Uso:      ./benchmarkFalsoCompartir [maxHilos] [millonesDeOperaciones]
+//           (por defecto 8 hilos y 4 millones de tomar+devolver por hilo)
+//
+// Nota: con menos núcleos que hilos no hay nada que medir (los hilos se turnan en el
+// mismo núcleo y la línea no viaja): hace falta una máquina con al menos maxHilos núcleos.
+
+#define _XOPEN_SOURCE 600
+#include <pthread.h>   // Para hilos y la barrera de largada
+#include <semaphore.h> // Para sem_trywait, sem_post
+#include <stdio.h>     // Para printf
+#include <stdlib.h>    // Para atoi, posix_memalign, free
+#include <time.h>      // Para clock_gettime
+#include "../Comun/lineaCache.h"
+
+enum { ATOMICAS_COMPACTAS, ATOMICAS_ALINEADAS, SEMAFOROS_COMPACTOS, SEMAFOROS_ALINEADOS, N_VARIANTES };
+
+static const char* const nombresVariante[N_VARIANTES] = {"Atómicas compactas", "Atómicas alineadas",
+                                                         "Semáforos compactos", "Semáforos alineados"};
+
+// -------- ESTADO COMPARTIDO DE UNA CORRIDA ----------
+int variante;
+long long operaciones;         // Tomar+devolver por hilo
+pthread_barrier_t largada;     // Todos los hilos arrancan juntos
+atomic_int* atomicasCompactas; // Como estacionesAtomicas.h antes: un int por estación
+PlazasAtomicas* atomicasAlineadas;
+sem_t* semaforosCompactos;     // Como mantenimientoDeTeslas.c antes: un sem_t por estación
+SemaforoEstacion* semaforosAlineados;
+
+double segundosEntre(struct timespec a, struct timespec b) {
+  return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+// Imprime "texto" rellenando hasta "ancho" columnas (printf cuenta bytes, no letras con tilde)
+void imprimirColumna(const char* texto, int ancho) {
+  int letras = 0;
+  for (const char* c = texto; *c; c++) {
+    letras += (*c & 0xC0) != 0x80;
+  }
+  printf("%s%*s", texto, ancho > letras ? ancho - letras : 0, "");
+}
+
+// Toma una plaza con CAS (lo mismo que estacionesAtomicasTomarEn) y la devuelve
+static inline void tomarYDevolverAtomica(atomic_int* plazas) {
+  int libres = atomic_load_explicit(plazas, memory_order_relaxed);
+  while (libres > 0 && !atomic_compare_exchange_weak_explicit(plazas, &libres, libres - 1, memory_order_acquire,
+                                                              memory_order_relaxed)) {
+  }
+  atomic_fetch_add_explicit(plazas, 1, memory_order_release);
+}
+
+// Cada hilo usa solo la estación con su número
+void* hiloEstacion(void* arg) {
+  int estacion = (int)(long)arg;
+  atomic_int* atomica = variante == ATOMICAS_COMPACTAS ? &atomicasCompactas[estacion]
+                                                       : &atomicasAlineadas[estacion].libres;
+  sem_t* semaforo = variante == SEMAFOROS_COMPACTOS ? &semaforosCompactos[estacion]
+                                                    : &semaforosAlineados[estacion].semaforo;
+  pthread_barrier_wait(&largada);
+  if (variante == ATOMICAS_COMPACTAS || variante == ATOMICAS_ALINEADAS) {
+    for (long long i = 0; i < operaciones; i++) {
+      tomarYDevolverAtomica(atomica);
+    }
+  } else {
+    for (long long i = 0; i < operaciones; i++) {
+      if (sem_trywait(semaforo) == 0) {
+        sem_post(semaforo);
+      }
+    }
+  }
+  return NULL;
+}
+
+/* ---------------------------------------------------------
+Corre "nHilos" hilos con la variante dada. Devuelve millones
+de tomar+devolver por segundo entre todos los hilos.
+------------------------------------------------------------*/
+double correr(int nHilos, int v) {
+  variante = v;
+  for (int i = 0; i < nHilos; i++) {
+    atomic_store(&atomicasCompactas[i], 3);
+    atomic_store(&atomicasAlineadas[i].libres, 3);
+    sem_init(&semaforosCompactos[i], 0, 3);
+    sem_init(&semaforosAlineados[i].semaforo, 0, 3);
+  }
+  pthread_barrier_init(&largada, NULL, nHilos + 1);
+  pthread_t hilos[nHilos];
+  for (int i = 0; i < nHilos; i++) {
+    if (pthread_create(&hilos[i], NULL, hiloEstacion, (void*)(long)i) != 0) {
+      fprintf(stderr, "No se pudo crear el hilo %d\n", i + 1);
+      exit(EXIT_FAILURE); // Los que ya se crearon quedarían esperando en la barrera
+    }
+  }
+
+  struct timespec inicio, fin;
+  pthread_barrier_wait(&largada);
+  clock_gettime(CLOCK_MONOTONIC, &inicio);
+  for (int i = 0; i < nHilos; i++) {
+    pthread_join(hilos[i], NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &fin);
+
+  pthread_barrier_destroy(&largada);
+  for (int i = 0; i < nHilos; i++) {
+    sem_destroy(&semaforosCompactos[i]);
+    sem_destroy(&semaforosAlineados[i].semaforo);
+  }
+  return nHilos * (double)operaciones / segundosEntre(inicio, fin) / 1e6;
+}
+
+int main(int argc, char const* argv[]) {
+  int maxHilos = argc > 1 ? atoi(argv[1]) : 8;
+  operaciones = (long long)((argc > 2 ? atof(argv[2]) : 4) * 1e6);
+  if (maxHilos < 1 || operaciones < 1) {
+    fprintf(stderr, "Uso: %s [maxHilos] [millonesDeOperaciones]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // Todos los arrays alineados a la línea, como los reserva afinidadReservar: así la
+  // versión compacta tiene exactamente 16 contadores (o 2 semáforos) por línea
+  if (posix_memalign((void**)&atomicasCompactas, LINEA_CACHE, sizeof(atomic_int) * maxHilos) != 0 ||
+      posix_memalign((void**)&atomicasAlineadas, LINEA_CACHE, sizeof(PlazasAtomicas) * maxHilos) != 0 ||
+      posix_memalign((void**)&semaforosCompactos, LINEA_CACHE, sizeof(sem_t) * maxHilos) != 0 ||
+      posix_memalign((void**)&semaforosAlineados, LINEA_CACHE, sizeof(SemaforoEstacion) * maxHilos) != 0) {
+    perror("No se pudo reservar memoria para las estaciones\n");
+    return EXIT_FAILURE;
+  }
+
+  printf("Millones de tomar+devolver por segundo (entre todos los hilos)\n");
+  printf("%-8s", "Hilos");
+  for (int v = 0; v < N_VARIANTES; v++) {
+    imprimirColumna(nombresVariante[v], 22);
+  }
+  printf("\n");
+  printf("------------------------------------------------------------------------------------------------\n");
+  for (int n = 1; n <= maxHilos; n = n < maxHilos && n * 2 > maxHilos ? maxHilos : n * 2) {
+    printf("%-8d", n);
+    for (int v = 0; v < N_VARIANTES; v++) {
+      printf("%-22.1f", correr(n, v));
+      fflush(stdout);
+    }
+    printf("\n");
+  }
+
+  free(atomicasCompactas);
+  free(atomicasAlineadas);
+  free(semaforosCompactos);
+  free(semaforosAlineados);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,276 @@
+// AFINIDAD DE CPU Y UBICACIÓN NUMA (--afinidad)
+//
+// Sin afinidad el planificador mueve los hilos de los autos de un núcleo a otro
+// mientras tocan el estado compartido de las estaciones, y en una máquina con varios
+// sockets ese estado puede quedar en la memoria del otro nodo. Con --afinidad:
+//
+//   - Las estaciones se reparten en bloques entre los nodos NUMA que el proceso puede
+//     usar (las primeras en el nodo 0, las siguientes en el 1, ...) y a cada una le
+//     toca un núcleo de su nodo.
+//   - Cada hilo (auto, trabajador del pool o hilo de fibras) se fija al núcleo de una
+//     estación, repartidos en ronda: el hilo k al núcleo de la estación k % nEstaciones.
+//   - El estado de cada estación que se reserva con afinidadReservar queda en la
+//     memoria de su nodo (mbind), con granularidad de página: las estaciones que
+//     comparten página quedan donde está la primera.
+//   - Al buscar plaza (politicaTomar) se prueban primero las estaciones del nodo del
+//     hilo y solo si están todas llenas las de los otros nodos.
+//
+// La topología sale de sched_getaffinity y /sys/devices/system/node (sin libnuma, para
+// que cada programa se siga compilando solo con gcc -pthread); fijar hilos y mbind son
+// llamadas directas al sistema. Con un solo nodo no se llama a mbind y las
+// estaciones no se filtran por nodo: solo queda fijar los hilos.
+
+#ifndef AFINIDAD_H
+#define AFINIDAD_H
+
+#include <dirent.h>      // Para recorrer /sys/devices/system/node
+#include <stdatomic.h>   // Para repartir los hilos en ronda
+#include <stdio.h>       // Para fopen, fprintf
+#include <stdlib.h>      // Para calloc, posix_memalign, free, strtol, atoi
+#include <string.h>      // Para strncmp, memset
+#include <sys/mman.h>    // Para mmap
+#include <sys/syscall.h> // Para SYS_sched_setaffinity, SYS_mbind
+#include <unistd.h>      // Para syscall, sysconf
+#include "lineaCache.h"  // Para LINEA_CACHE
+
+#define AFINIDAD_MAX_CPUS 1024
+#define AFINIDAD_PALABRAS (AFINIDAD_MAX_CPUS / (8 * sizeof(unsigned long)))
+#define AFINIDAD_BITS (8 * sizeof(unsigned long))
+
+// Con _XOPEN_SOURCE 600 unistd.h no declara syscall() ni sys/mman.h MAP_ANONYMOUS (ver futex.h)
+long syscall(long numero, ...);
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS 0x20 // El valor de Linux
+#endif
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1 // Igual que en <numaif.h>: el nodo pedido si tiene memoria libre
+#endif
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE (1 << 1)
+#endif
+
+typedef struct {
+  int activa;          // 0 = sin --afinidad (los hilos corren donde quiera el planificador)
+  int nCpus;
+  int cpus[AFINIDAD_MAX_CPUS];  // CPUs que el proceso puede usar, agrupadas por nodo
+  int nodos[AFINIDAD_MAX_CPUS]; // Nodo NUMA de cada una de esas CPUs
+  int nNodos;          // Nodos con al menos una CPU usable
+  int idsNodo[AFINIDAD_MAX_CPUS]; // Número de cada uno de esos nodos en el sistema (para mbind)
+  int nEstaciones;
+  int* cpuDeEstacion;  // Núcleo de cada estación (0..n-1)
+  int* nodoDeEstacion; // Nodo de cada estación (índice en 0..nNodos-1)
+  atomic_int siguienteHilo;
+} Afinidad;
+
+static Afinidad afinidad;
+
+// Nodo (0..nNodos-1) del núcleo al que se fijó este hilo, o -1 si no se fijó
+static _Thread_local int nodoDelHilo = -1;
+
+// Marca en "mascara" las CPUs de una lista de /sys como "0-3,8-11"
+static void afinidadLeerLista(const char* lista, unsigned long* mascara) {
+  const char* p = lista;
+  while (*p >= '0' && *p <= '9') {
+    char* fin;
+    long desde = strtol(p, &fin, 10), hasta = desde;
+    if (*fin == '-') {
+      hasta = strtol(fin + 1, &fin, 10);
+    }
+    for (long c = desde; c <= hasta && c < AFINIDAD_MAX_CPUS; c++) {
+      mascara[c / AFINIDAD_BITS] |= 1ul << (c % AFINIDAD_BITS);
+    }
+    p = *fin == ',' ? fin + 1 : fin;
+  }
+}
+
+// 1 si la CPU "c" está marcada en la máscara
+static int afinidadTieneCpu(const unsigned long* mascara, int c) {
+  return (int)((mascara[c / AFINIDAD_BITS] >> (c % AFINIDAD_BITS)) & 1ul);
+}
+
+/* ---------------------------------------------------------
+Lee qué CPUs puede usar el proceso y de qué nodo es cada una,
+y le asigna núcleo y nodo a cada estación. Llamar antes de
+reservar el estado de las estaciones y de crear los hilos.
+Devuelve -1 si no se pudo.
+------------------------------------------------------------*/
+static inline int afinidadIniciar(int nEstaciones) {
+  unsigned long permitidas[AFINIDAD_PALABRAS] = {0};
+  if (syscall(SYS_sched_getaffinity, 0, sizeof(permitidas), permitidas) < 0) {
+    return -1;
+  }
+  afinidad.nCpus = 0;
+  afinidad.nNodos = 0;
+
+  // 1) CPUS DE CADA NODO (en el orden de los nodos)
+  // ---------------------------------------------------
+  unsigned long yaVistas[AFINIDAD_PALABRAS] = {0};
+  DIR* dir = opendir("/sys/devices/system/node");
+  struct dirent* entrada;
+  while (dir && (entrada = readdir(dir)) != NULL) {
+    if (strncmp(entrada->d_name, "node", 4) != 0 || entrada->d_name[4] < '0' || entrada->d_name[4] > '9') {
+      continue;
+    }
+    char ruta[300], lista[4096];
+    snprintf(ruta, sizeof(ruta), "/sys/devices/system/node/%s/cpulist", entrada->d_name);
+    FILE* archivo = fopen(ruta, "r");
+    if (!archivo) {
+      continue;
+    }
+    unsigned long delNodo[AFINIDAD_PALABRAS] = {0};
+    if (fgets(lista, sizeof(lista), archivo)) {
+      afinidadLeerLista(lista, delNodo);
+    }
+    fclose(archivo);
+    int antes = afinidad.nCpus;
+    for (int c = 0; c < AFINIDAD_MAX_CPUS; c++) {
+      if (afinidadTieneCpu(delNodo, c) && afinidadTieneCpu(permitidas, c) && !afinidadTieneCpu(yaVistas, c)) {
+        yaVistas[c / AFINIDAD_BITS] |= 1ul << (c % AFINIDAD_BITS);
+        afinidad.cpus[afinidad.nCpus] = c;
+        afinidad.nodos[afinidad.nCpus++] = afinidad.nNodos;
+      }
+    }
+    if (afinidad.nCpus > antes) {
+      afinidad.idsNodo[afinidad.nNodos++] = atoi(entrada->d_name + 4);
+    }
+  }
+  if (dir) {
+    closedir(dir);
+  }
+  // Sin /sys (o CPUs que no figuran en ningún nodo): van todas a un nodo más
+  int antes = afinidad.nCpus;
+  for (int c = 0; c < AFINIDAD_MAX_CPUS; c++) {
+    if (afinidadTieneCpu(permitidas, c) && !afinidadTieneCpu(yaVistas, c)) {
+      afinidad.cpus[afinidad.nCpus] = c;
+      afinidad.nodos[afinidad.nCpus++] = afinidad.nNodos;
+    }
+  }
+  if (afinidad.nCpus > antes) {
+    afinidad.idsNodo[afinidad.nNodos++] = 0;
+  }
+  if (afinidad.nCpus == 0) {
+    return -1;
+  }
+
+  // 2) NÚCLEO Y NODO DE CADA ESTACIÓN
+  // ---------------------------------------------------
+  // Bloques consecutivos de estaciones por nodo, así el estado de las de un mismo
+  // nodo queda contiguo en memoria y se puede ubicar por páginas
+  afinidad.nEstaciones = nEstaciones;
+  afinidad.cpuDeEstacion = calloc(nEstaciones > 0 ? nEstaciones : 1, sizeof(int));
+  afinidad.nodoDeEstacion = calloc(nEstaciones > 0 ? nEstaciones : 1, sizeof(int));
+  if (!afinidad.cpuDeEstacion || !afinidad.nodoDeEstacion) {
+    free(afinidad.cpuDeEstacion);
+    free(afinidad.nodoDeEstacion);
+    return -1;
+  }
+  int primeraCpu = 0, primeraEstacion = 0;
+  for (int nodo = 0; nodo < afinidad.nNodos; nodo++) {
+    int cpusDelNodo = 0;
+    while (primeraCpu + cpusDelNodo < afinidad.nCpus && afinidad.nodos[primeraCpu + cpusDelNodo] == nodo) {
+      cpusDelNodo++;
+    }
+    int hasta = (int)((long long)nEstaciones * (nodo + 1) / afinidad.nNodos);
+    for (int i = primeraEstacion; i < hasta; i++) {
+      afinidad.nodoDeEstacion[i] = nodo;
+      afinidad.cpuDeEstacion[i] = afinidad.cpus[primeraCpu + (i - primeraEstacion) % cpusDelNodo];
+    }
+    primeraCpu += cpusDelNodo;
+    primeraEstacion = hasta;
+  }
+  atomic_init(&afinidad.siguienteHilo, 0);
+  afinidad.activa = 1;
+  // A stderr, para no mezclarla con los mensajes de los autos en stdout
+  fprintf(stderr, "Afinidad: %d CPUs en %d nodo%s NUMA; estación 1 en la CPU %d", afinidad.nCpus,
+          afinidad.nNodos, afinidad.nNodos == 1 ? "" : "s", nEstaciones > 0 ? afinidad.cpuDeEstacion[0] : -1);
+  if (nEstaciones > 1) {
+    fprintf(stderr, ", estación %d en la CPU %d", nEstaciones, afinidad.cpuDeEstacion[nEstaciones - 1]);
+  }
+  fprintf(stderr, "\n");
+  return 0;
+}
+
+/* ---------------------------------------------------------
+Fija el hilo que la llama al núcleo de la siguiente estación
+en ronda (llamar al principio de cada hilo). Sin --afinidad
+no hace nada.
+------------------------------------------------------------*/
+static inline void afinidadFijarHilo(void) {
+  if (!afinidad.activa || afinidad.nEstaciones <= 0) {
+    return;
+  }
+  int estacion = atomic_fetch_add_explicit(&afinidad.siguienteHilo, 1, memory_order_relaxed) % afinidad.nEstaciones;
+  int cpu = afinidad.cpuDeEstacion[estacion];
+  unsigned long mascara[AFINIDAD_PALABRAS] = {0};
+  mascara[cpu / AFINIDAD_BITS] = 1ul << (cpu % AFINIDAD_BITS);
+  // pid 0 = este hilo (sched_setaffinity trabaja por hilo, no por proceso)
+  if (syscall(SYS_sched_setaffinity, 0, sizeof(mascara), mascara) == 0) {
+    nodoDelHilo = afinidad.nodoDeEstacion[estacion];
+  }
+}
+
+// 1 si conviene filtrar estaciones por nodo: hay más de un nodo y este hilo está fijado
+static inline int afinidadPreferirNodo(void) {
+  return afinidad.activa && afinidad.nNodos > 1 && nodoDelHilo >= 0;
+}
+
+// 1 si la estación i (0..n-1) está en el nodo de este hilo
+static inline int afinidadEstacionCercana(int i) {
+  return afinidad.nodoDeEstacion[i] == nodoDelHilo;
+}
+
+static size_t afinidadTamReserva(int nEstaciones, size_t tamPorEstacion) {
+  size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+  size_t tam = tamPorEstacion * (size_t)(nEstaciones > 0 ? nEstaciones : 1);
+  return (tam + pagina - 1) / pagina * pagina;
+}
+
+/* ---------------------------------------------------------
+Reserva un array en ceros con "tamPorEstacion" bytes por
+estación, alineado a la línea de caché (ver lineaCache.h).
+Con --afinidad y varios nodos, las páginas de cada estación
+quedan en su nodo. Se libera con afinidadLiberar.
+------------------------------------------------------------*/
+static void* afinidadReservar(int nEstaciones, size_t tamPorEstacion) {
+  if (!afinidad.activa) {
+    size_t tam = tamPorEstacion * (size_t)(nEstaciones > 0 ? nEstaciones : 1);
+    void* memoria;
+    if (posix_memalign(&memoria, LINEA_CACHE, tam) != 0) {
+      return NULL;
+    }
+    return memset(memoria, 0, tam);
+  }
+  size_t tam = afinidadTamReserva(nEstaciones, tamPorEstacion);
+  char* memoria = mmap(NULL, tam, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memoria == MAP_FAILED) {
+    return NULL;
+  }
+#ifdef SYS_mbind
+  if (afinidad.nNodos > 1) {
+    // Las páginas todavía no se tocaron: cada una va al nodo de la primera estación que empieza en ella
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    for (size_t inicio = 0; inicio < tam; inicio += pagina) {
+      int estacion = (int)(inicio / tamPorEstacion);
+      if (estacion >= nEstaciones) {
+        break;
+      }
+      int id = afinidad.idsNodo[afinidad.nodoDeEstacion[estacion]];
+      unsigned long nodo[AFINIDAD_PALABRAS] = {0};
+      nodo[id / AFINIDAD_BITS] = 1ul << (id % AFINIDAD_BITS);
+      // Si no se puede (kernel sin NUMA) la página queda donde la ponga el kernel
+      syscall(SYS_mbind, memoria + inicio, pagina, MPOL_PREFERRED, nodo, AFINIDAD_MAX_CPUS, MPOL_MF_MOVE);
+    }
+  }
+#endif
+  return memoria;
+}
+
+static void afinidadLiberar(void* memoria, int nEstaciones, size_t tamPorEstacion) {
+  if (!afinidad.activa) {
+    free(memoria);
+  } else if (memoria) {
+    munmap(memoria, afinidadTamReserva(nEstaciones, tamPorEstacion));
+  }
+}
+
+#endif
@@ -0,0 +1,200 @@
+// ADMISIÓN Y SALIDA COMBINADAS BAJO UNA SOLA TOMA DEL CANDADO (--combinar)
+//
+// Con la variable de condición cada auto toma el mutex de las estaciones para entrar,
+// otra vez para salir y otra más cada vez que lo despiertan: con miles de autos el
+// tiempo se va en pasarse el mutex de un hilo a otro. Acá (flat combining) cada auto
+// deja su pedido (entrar o salir) en una pila sin candado y trata de tomar el candado
+// con trylock. El que lo consigue es el "combinador": se lleva la pila entera de una
+// vez, devuelve todas las plazas de los que salen, anota a los que quieren entrar en la
+// fila de espera, reparte las plazas libres entre los primeros de la fila y suelta el
+// candado. Recién después despierta a los admitidos, cada uno en su propia casilla
+// (una palabra futex, como en traspaso.h). Los que no consiguieron el candado no se
+// bloquean en él: su pedido ya está en la pila y lo atiende el combinador de turno.
+//
+// El combinador, al soltar el candado, vuelve a mirar la pila: si llegó un pedido
+// mientras combinaba (y su dueño no pudo tomar el candado), lo atiende él. Así ningún
+// pedido queda olvidado sin que nadie duerma esperando el candado. Para eso hacen falta
+// dos barreras seq_cst: una entre apilar el pedido y el trylock, y otra entre soltar el
+// candado y volver a mirar la pila. Un trylock fallido no sincroniza con nada y el
+// unlock es solo release, así que sin ellas (en ARM o POWER) el que apiló puede ver el
+// candado tomado mientras el combinador ve la pila vacía, y se van los dos.
+//
+// Salir no espera nada: el auto deja su pedido y sigue. La fila de espera es la de
+// prioridades.h, así que con --prioridades también se respeta la clase de cada auto.
+// Al final se imprime cuántos pedidos se atendieron por cada toma del candado.
+
+#ifndef COMBINADOR_H
+#define COMBINADOR_H
+
+#include <pthread.h>     // Para el candado del combinador
+#include <stdatomic.h>   // Para la pila de pedidos y las casillas
+#include <stdio.h>       // Para printf
+#include <stdlib.h>      // Para calloc, free
+#include "futex.h"       // Para futexEsperar, futexDespertar
+#include "prioridades.h" // Para la fila de espera (una sub-fila por clase)
+
+enum { PEDIDO_ENTRAR, PEDIDO_SALIR };
+
+// Estados de la casilla de un auto que pidió entrar (si no, tiene su estación, 1..n)
+#define COMBINADOR_PENDIENTE 0 // Todavía no le dieron plaza
+#define COMBINADOR_DUERME -1   // Sin plaza y bloqueado en el futex
+
+typedef struct PedidoCombinado {
+  EnFila enFila;                      // Lugar en la fila de espera (primer campo)
+  struct PedidoCombinado* siguiente;  // Siguiente en la pila de pedidos (o en el lote)
+  int tipo;                           // PEDIDO_*
+  int indiceAuto;
+  int estacion;                       // La que devuelve (salir) o la que le tocó (entrar)
+  atomic_int casilla;                 // Estado o estación asignada (solo entrar)
+} PedidoCombinado;
+
+typedef struct {
+  pthread_mutex_t candado;                // Lo tiene el combinador (protege todo lo de abajo)
+  _Atomic(PedidoCombinado*) pendientes;   // Pila de pedidos sin atender (sin candado)
+  PedidoCombinado* pedidos;               // pedidos[i] = el del auto i+1 (entrar y después salir)
+  FilaPrioridades esperando;              // Autos que pidieron entrar y no tienen plaza
+  int (*tomar)(void);                     // Toma una plaza (1..n o -1), con el candado
+  void (*liberar)(int estacion);          // Devuelve una plaza, con el candado
+  long long tomas;                        // Veces que alguien combinó
+  long long atendidos;                    // Pedidos atendidos entre todas las tomas
+} Combinador;
+
+// Reserva un pedido por auto. Devuelve -1 si no hay memoria.
+static int combinadorIniciar(Combinador* c, int nAutos, int (*tomar)(void), void (*liberar)(int estacion)) {
+  pthread_mutex_init(&c->candado, NULL);
+  atomic_init(&c->pendientes, NULL);
+  filaPrioridadesIniciar(&c->esperando);
+  c->tomar = tomar;
+  c->liberar = liberar;
+  c->tomas = c->atendidos = 0;
+  c->pedidos = calloc(nAutos > 0 ? nAutos : 1, sizeof(PedidoCombinado));
+  return c->pedidos ? 0 : -1;
+}
+
+static void combinadorDestruir(Combinador* c) {
+  pthread_mutex_destroy(&c->candado);
+  free(c->pedidos);
+}
+
+// Apila el pedido sin candado (pila de Treiber)
+static void combinadorPublicar(Combinador* c, PedidoCombinado* p) {
+  PedidoCombinado* cabeza = atomic_load_explicit(&c->pendientes, memory_order_relaxed);
+  do {
+    p->siguiente = cabeza;
+  } while (!atomic_compare_exchange_weak_explicit(&c->pendientes, &cabeza, p, memory_order_release,
+                                                  memory_order_relaxed));
+}
+
+/* ---------------------------------------------------------
+Mientras haya pedidos en la pila y el candado esté libre, se
+convierte en combinador: atiende la pila entera con una sola
+toma del candado y, ya sin candado, despierta a los que
+consiguieron plaza. Si el candado está tomado no espera: el
+que lo tiene vuelve a mirar la pila antes de irse.
+------------------------------------------------------------*/
+static void combinadorCombinar(Combinador* c) {
+  // El pedido recién apilado tiene que ser visible antes de probar el candado
+  atomic_thread_fence(memory_order_seq_cst);
+  while (atomic_load(&c->pendientes) && pthread_mutex_trylock(&c->candado) == 0) {
+    // La pila quedó al revés: la doy vuelta para atender en orden de llegada
+    PedidoCombinado* lote = atomic_exchange_explicit(&c->pendientes, NULL, memory_order_acquire);
+    PedidoCombinado* enOrden = NULL;
+    while (lote) {
+      PedidoCombinado* siguiente = lote->siguiente;
+      lote->siguiente = enOrden;
+      enOrden = lote;
+      lote = siguiente;
+    }
+
+    // 1) Primero las salidas (liberan plazas) y la fila para las entradas
+    long long atendidos = 0;
+    for (PedidoCombinado* p = enOrden; p; p = p->siguiente) {
+      atendidos++;
+      if (p->tipo == PEDIDO_SALIR) {
+        c->liberar(p->estacion);
+      } else {
+        filaPrioridadesPoner(&c->esperando, &p->enFila, p->indiceAuto);
+      }
+    }
+
+    // 2) Reparto las plazas libres entre los primeros de la fila
+    PedidoCombinado *admitidos = NULL, *ultimo = NULL;
+    while (!filaPrioridadesVacia(&c->esperando)) {
+      int estacion = c->tomar();
+      if (estacion < 0) {
+        break; // Los demás siguen en la fila hasta que alguien salga
+      }
+      PedidoCombinado* p = (PedidoCombinado*)filaPrioridadesSacar(&c->esperando);
+      p->estacion = estacion;
+      p->siguiente = NULL;
+      if (ultimo) {
+        ultimo->siguiente = p;
+      } else {
+        admitidos = p;
+      }
+      ultimo = p;
+    }
+    c->tomas++;
+    c->atendidos += atendidos;
+    pthread_mutex_unlock(&c->candado);
+    // Soltar el candado tiene que ser visible antes de volver a mirar la pila
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // 3) Despierto a los admitidos todos juntos, ya sin el candado
+    while (admitidos) {
+      PedidoCombinado* p = admitidos;
+      admitidos = p->siguiente; // Antes de entregar: el auto despierto puede reusar su pedido
+      if (atomic_exchange(&p->casilla, p->estacion) == COMBINADOR_DUERME) {
+        futexDespertar(&p->casilla, 1);
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------
+El auto "indiceAuto" (1..nAutos) pide entrar y trata de
+combinar. Devuelve su estación si ya se la dieron (él mismo u
+otro combinador) o -1 si tiene que esperar con
+combinadorEsperarEntrada.
+------------------------------------------------------------*/
+static int combinadorPedirEntrada(Combinador* c, int indiceAuto) {
+  PedidoCombinado* p = &c->pedidos[indiceAuto - 1];
+  p->tipo = PEDIDO_ENTRAR;
+  p->indiceAuto = indiceAuto;
+  atomic_store_explicit(&p->casilla, COMBINADOR_PENDIENTE, memory_order_relaxed);
+  combinadorPublicar(c, p);
+  combinadorCombinar(c);
+  int estacion = atomic_load(&p->casilla);
+  return estacion > 0 ? estacion : -1;
+}
+
+// Duerme hasta que un combinador le dé plaza al auto y devuelve su estación (1..n)
+static int combinadorEsperarEntrada(Combinador* c, int indiceAuto) {
+  atomic_int* casilla = &c->pedidos[indiceAuto - 1].casilla;
+  int estacion = COMBINADOR_PENDIENTE;
+  if (!atomic_compare_exchange_strong(casilla, &estacion, COMBINADOR_DUERME)) {
+    return estacion; // Me la dieron mientras tanto
+  }
+  while ((estacion = atomic_load(casilla)) <= 0) {
+    futexEsperar(casilla, COMBINADOR_DUERME);
+  }
+  return estacion;
+}
+
+// El auto deja su pedido de salida de "estacion" (1..n) y sigue sin esperar
+static void combinadorSalir(Combinador* c, int indiceAuto, int estacion) {
+  PedidoCombinado* p = &c->pedidos[indiceAuto - 1];
+  p->tipo = PEDIDO_SALIR;
+  p->indiceAuto = indiceAuto;
+  p->estacion = estacion;
+  combinadorPublicar(c, p);
+  combinadorCombinar(c);
+}
+
+// Pedidos atendidos por cada toma del candado (llamar después de que terminaron los hilos)
+static void combinadorImprimir(const Combinador* c) {
+  printf("Combinación: %lld pedidos en %lld tomas del candado (%.1f pedidos por toma)\n", c->atendidos,
+         c->tomas, c->tomas ? (double)c->atendidos / c->tomas : 0.0);
+}
+
+#endif
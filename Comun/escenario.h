@@ -0,0 +1,556 @@
+// ESCENARIO: ESTACIONES CON CAPACIDADES DISTINTAS, TAREAS CON TIEMPOS ALEATORIOS Y PERFILES DE AUTOS
+//
+// El archivo de configuración puede tener los 3 números de siempre (nAutos,
+// nEstaciones y capacidadXEstacion) o un escenario completo, una directiva por línea
+// ('#' empieza un comentario):
+//
+//   autos 100000
+//   semilla 42                        (opcional; misma semilla = mismos tiempos por auto)
+//   estacion 3                        una estación con 3 plazas
+//   estacion 2 x100000                100000 estaciones con 2 plazas cada una
+//   tarea fija 1.0 BATERÍA            siempre 1 segundo
+//   tarea exponencial 0.5 MOTOR       exponencial con media 0.5 s
+//   tarea lognormal 0.0 0.25 DIRECCIÓN    lognormal: media y desvío del logaritmo de los segundos
+//   perfil 1-500 1 2                  los autos 1 a 500 solo hacen las tareas 1 y 2
+//   clase flota 1-200                 prioridad de los autos 1 a 200 (flota, garantia o
+//                                     particular; ver prioridades.h, solo con --prioridades)
+//   envejecimiento 2.0                cada 2 s de espera un auto sube una clase (por defecto 5)
+//   etapa 2 3 8                       en la línea de montaje (--linea del motor) la tarea 2
+//                                     tiene 3 bahías y una cola de entrada de 8 autos
+//   depende 4 1 2                     con técnicos (--tecnicos) la tarea 4 empieza recién
+//                                     cuando el auto terminó las tareas 1 y 2 (solo de
+//                                     tareas anteriores, así que no puede haber ciclos)
+//   llegadas poisson 50               en el motor los autos llegan de a uno, 50 por segundo
+//   llegadas rafagas 50 10            de a 10 juntos, 50 por segundo en promedio
+//   llegadas diurna 50 60             50 por segundo en promedio, subiendo y bajando con
+//                                     un ciclo de 60 s (ver Motor/llegadas.h)
+//   sala 20 rechazar                  sala de espera para 20 autos; si está llena el que
+//                                     llega espera afuera (bloquear, por defecto), se va
+//                                     (rechazar) o echa al que más esperó (descartar)
+//
+// El nombre de la tarea es el resto de la línea (puede tener espacios). Sin líneas
+// "tarea" se usan las tareas del programa con su duración de siempre; los autos que
+// no están en ningún perfil hacen todas las tareas y los que no están en ninguna clase
+// son particulares. Los rangos de "perfil" (y los de "clase") pueden ir en cualquier
+// orden pero no pisarse, y cada uno va de menor a mayor. El archivo se lee con mmap
+// y se recorre una sola vez, así que escenarios con cientos de miles de estaciones
+// cargan en milisegundos.
+//
+// Los tiempos aleatorios usan log/exp, así que los programas se compilan con -lm.
+
+#ifndef ESCENARIO_H
+#define ESCENARIO_H
+
+#include <fcntl.h>     // Para open
+#include <math.h>      // Para log, exp, sqrt, cos
+#include <stdint.h>    // Para uint32_t, uint64_t
+#include <stdlib.h>    // Para malloc, realloc, free, qsort, strtod
+#include <string.h>    // Para memcpy, memcmp
+#include <sys/mman.h>  // Para mmap, posix_madvise
+#include <sys/stat.h>  // Para fstat
+#include <time.h>      // Para nanosleep
+#include <unistd.h>    // Para close
+
+// Máximo de tareas (cada perfil guarda sus tareas en una máscara de 32 bits)
+#define MAX_TAREAS 32
+
+enum { DURACION_FIJA, DURACION_EXPONENCIAL, DURACION_LOGNORMAL };
+
+typedef struct {
+  int tipo;          // DURACION_*
+  double parametro1; // Segundos (fija), media (exponencial) o media del logaritmo (lognormal)
+  double parametro2; // Desvío del logaritmo (solo lognormal)
+} DuracionTarea;
+
+typedef struct {
+  int desde, hasta;  // Rango de autos (inclusive)
+  uint32_t tareas;   // Bit i = hace la tarea i
+} PerfilAutos;
+
+// Cómo llegan los autos: todos juntos en t = 0 (lo de siempre) o de a poco
+enum { LLEGADAS_JUNTAS, LLEGADAS_POISSON, LLEGADAS_RAFAGAS, LLEGADAS_DIURNAS };
+// Qué pasa cuando llega un auto y la sala de espera está llena
+enum { SALA_BLOQUEAR, SALA_RECHAZAR, SALA_DESCARTAR };
+
+// Clases de prioridad, de la más urgente a la menos (ver prioridades.h)
+enum { CLASE_FLOTA, CLASE_GARANTIA, CLASE_PARTICULAR, N_CLASES };
+
+typedef struct {
+  int desde, hasta;  // Rango de autos (inclusive)
+  int clase;         // CLASE_*
+} ClaseAutos;
+
+typedef struct {
+  int nAutos;
+  int nEstaciones;
+  int* capacidades;          // Plazas de cada estación (índice 0 = estación 1)
+  long long plazasTotales;   // Suma de todas las capacidades
+  int nTareas;
+  char* nombresTareas[MAX_TAREAS];
+  DuracionTarea duraciones[MAX_TAREAS];
+  PerfilAutos* perfiles;     // Ordenados por "desde"
+  int nPerfiles;
+  ClaseAutos* clases;        // Ordenadas por "desde"
+  int nClases;
+  double envejecimiento;     // Segundos de espera para subir una clase
+  int bahiasEtapa[MAX_TAREAS]; // Bahías de la etapa de cada tarea en --linea (0 = por defecto)
+  int colaEtapa[MAX_TAREAS];   // Lugares de la cola de entrada de cada etapa (0 = por defecto)
+  uint32_t requisitos[MAX_TAREAS]; // Bit j de requisitos[i] = la tarea i va después de la j
+  int llegadas;              // LLEGADAS_*
+  double tasaLlegadas;       // Autos por segundo, en promedio
+  double parametroLlegadas;  // Autos por ráfaga o segundos de cada ciclo diurno
+  int capacidadSala;         // Autos que pueden esperar a la vez (0 = sin límite)
+  int politicaSala;          // SALA_*
+  uint64_t semilla;
+  int nombresPropios;        // 1 si los nombres de las tareas se reservaron al leer
+} Escenario;
+
+// Cursor sobre el archivo mapeado (nunca se lee más allá de "fin")
+typedef struct {
+  const char* p;
+  const char* fin;
+} LectorEscenario;
+
+static void escenarioSaltarBlancos(LectorEscenario* l) {
+  while (l->p < l->fin && (*l->p == ' ' || *l->p == '\t' || *l->p == '\r')) {
+    l->p++;
+  }
+}
+
+static void escenarioSaltarLinea(LectorEscenario* l) {
+  while (l->p < l->fin && *l->p != '\n') {
+    l->p++;
+  }
+  if (l->p < l->fin) {
+    l->p++;
+  }
+}
+
+// Lee un entero no negativo; devuelve -1 si no hay uno
+static long long escenarioLeerEntero(LectorEscenario* l) {
+  escenarioSaltarBlancos(l);
+  if (l->p >= l->fin || *l->p < '0' || *l->p > '9') {
+    return -1;
+  }
+  long long valor = 0;
+  while (l->p < l->fin && *l->p >= '0' && *l->p <= '9') {
+    valor = valor * 10 + (*l->p++ - '0');
+  }
+  return valor;
+}
+
+// Lee un número con decimales (copiándolo, porque el mapa no termina en '\0')
+static int escenarioLeerReal(LectorEscenario* l, double* valor) {
+  escenarioSaltarBlancos(l);
+  char copia[64];
+  size_t n = 0;
+  while (l->p < l->fin && n < sizeof(copia) - 1 && *l->p != ' ' && *l->p != '\t' &&
+         *l->p != '\n' && *l->p != '\r') {
+    copia[n++] = *l->p++;
+  }
+  copia[n] = '\0';
+  char* resto;
+  *valor = strtod(copia, &resto);
+  return n > 0 && *resto == '\0' ? 0 : -1;
+}
+
+// Compara la siguiente palabra con "palabra" y la consume si coincide
+static int escenarioPalabra(LectorEscenario* l, const char* palabra) {
+  escenarioSaltarBlancos(l);
+  size_t largo = strlen(palabra);
+  if ((size_t)(l->fin - l->p) < largo || memcmp(l->p, palabra, largo) != 0) {
+    return 0;
+  }
+  const char* despues = l->p + largo;
+  if (despues < l->fin && *despues != ' ' && *despues != '\t' && *despues != '\n' && *despues != '\r') {
+    return 0;
+  }
+  l->p = despues;
+  return 1;
+}
+
+// Agrega "cantidad" estaciones con "capacidad" plazas
+static int escenarioAgregarEstaciones(Escenario* e, int* reservadas, int capacidad, long long cantidad) {
+  while (e->nEstaciones + cantidad > *reservadas) {
+    int nuevas = *reservadas ? 2 * *reservadas : 1024;
+    int* capacidades = realloc(e->capacidades, sizeof(int) * nuevas);
+    if (!capacidades) {
+      return -1;
+    }
+    e->capacidades = capacidades;
+    *reservadas = nuevas;
+  }
+  for (long long i = 0; i < cantidad; i++) {
+    e->capacidades[e->nEstaciones++] = capacidad;
+  }
+  e->plazasTotales += (long long)capacidad * cantidad;
+  return 0;
+}
+
+static int escenarioCompararPerfiles(const void* a, const void* b) {
+  return ((const PerfilAutos*)a)->desde - ((const PerfilAutos*)b)->desde;
+}
+
+static int escenarioCompararClases(const void* a, const void* b) {
+  return ((const ClaseAutos*)a)->desde - ((const ClaseAutos*)b)->desde;
+}
+
+// Recorre el escenario completo; devuelve -1 ante una línea que no entiende
+static int escenarioInterpretar(LectorEscenario* l, Escenario* e) {
+  int estacionesReservadas = 0, perfilesReservados = 0, clasesReservadas = 0;
+  while (l->p < l->fin) {
+    escenarioSaltarBlancos(l);
+    if (l->p >= l->fin || *l->p == '\n' || *l->p == '#') {
+      escenarioSaltarLinea(l);
+      continue;
+    }
+    if (escenarioPalabra(l, "autos")) {
+      e->nAutos = (int)escenarioLeerEntero(l);
+    } else if (escenarioPalabra(l, "semilla")) {
+      e->semilla = (uint64_t)escenarioLeerEntero(l);
+    } else if (escenarioPalabra(l, "estacion")) {
+      long long capacidad = escenarioLeerEntero(l), cantidad = 1;
+      escenarioSaltarBlancos(l);
+      if (l->p < l->fin && *l->p == 'x') {
+        l->p++;
+        cantidad = escenarioLeerEntero(l);
+      }
+      if (capacidad < 0 || cantidad < 0 ||
+          escenarioAgregarEstaciones(e, &estacionesReservadas, (int)capacidad, cantidad) != 0) {
+        return -1;
+      }
+    } else if (escenarioPalabra(l, "tarea")) {
+      if (!e->nombresPropios) {
+        e->nTareas = 0; // La primera "tarea" reemplaza a las del programa
+        e->nombresPropios = 1;
+      }
+      if (e->nTareas == MAX_TAREAS) {
+        return -1;
+      }
+      DuracionTarea* d = &e->duraciones[e->nTareas];
+      d->parametro2 = 0;
+      if (escenarioPalabra(l, "fija")) {
+        d->tipo = DURACION_FIJA;
+      } else if (escenarioPalabra(l, "exponencial")) {
+        d->tipo = DURACION_EXPONENCIAL;
+      } else if (escenarioPalabra(l, "lognormal")) {
+        d->tipo = DURACION_LOGNORMAL;
+      } else {
+        return -1;
+      }
+      if (escenarioLeerReal(l, &d->parametro1) != 0 ||
+          (d->tipo == DURACION_LOGNORMAL && escenarioLeerReal(l, &d->parametro2) != 0)) {
+        return -1;
+      }
+      // El nombre es el resto de la línea, sin blancos al final
+      escenarioSaltarBlancos(l);
+      const char* inicio = l->p;
+      while (l->p < l->fin && *l->p != '\n' && *l->p != '#') {
+        l->p++;
+      }
+      const char* final = l->p;
+      while (final > inicio && (final[-1] == ' ' || final[-1] == '\t' || final[-1] == '\r')) {
+        final--;
+      }
+      char* nombre = malloc(final - inicio + 1);
+      if (!nombre || final == inicio) {
+        free(nombre);
+        return -1;
+      }
+      memcpy(nombre, inicio, final - inicio);
+      nombre[final - inicio] = '\0';
+      e->nombresTareas[e->nTareas++] = nombre;
+    } else if (escenarioPalabra(l, "perfil")) {
+      if (e->nPerfiles == perfilesReservados) {
+        perfilesReservados = perfilesReservados ? 2 * perfilesReservados : 16;
+        PerfilAutos* perfiles = realloc(e->perfiles, sizeof(PerfilAutos) * perfilesReservados);
+        if (!perfiles) {
+          return -1;
+        }
+        e->perfiles = perfiles;
+      }
+      PerfilAutos* perfil = &e->perfiles[e->nPerfiles++];
+      perfil->desde = (int)escenarioLeerEntero(l);
+      if (l->p >= l->fin || *l->p++ != '-') {
+        return -1;
+      }
+      perfil->hasta = (int)escenarioLeerEntero(l);
+      if (perfil->hasta < perfil->desde) {
+        return -1;
+      }
+      perfil->tareas = 0;
+      long long tarea;
+      while ((tarea = escenarioLeerEntero(l)) > 0) {
+        if (tarea > MAX_TAREAS) {
+          return -1;
+        }
+        perfil->tareas |= 1u << (tarea - 1);
+      }
+    } else if (escenarioPalabra(l, "clase")) {
+      if (e->nClases == clasesReservadas) {
+        clasesReservadas = clasesReservadas ? 2 * clasesReservadas : 16;
+        ClaseAutos* clases = realloc(e->clases, sizeof(ClaseAutos) * clasesReservadas);
+        if (!clases) {
+          return -1;
+        }
+        e->clases = clases;
+      }
+      ClaseAutos* clase = &e->clases[e->nClases++];
+      if (escenarioPalabra(l, "flota")) {
+        clase->clase = CLASE_FLOTA;
+      } else if (escenarioPalabra(l, "garantia")) {
+        clase->clase = CLASE_GARANTIA;
+      } else if (escenarioPalabra(l, "particular")) {
+        clase->clase = CLASE_PARTICULAR;
+      } else {
+        return -1;
+      }
+      clase->desde = (int)escenarioLeerEntero(l);
+      if (l->p >= l->fin || *l->p++ != '-') {
+        return -1;
+      }
+      clase->hasta = (int)escenarioLeerEntero(l);
+      if (clase->hasta < clase->desde) {
+        return -1;
+      }
+    } else if (escenarioPalabra(l, "envejecimiento")) {
+      if (escenarioLeerReal(l, &e->envejecimiento) != 0 || e->envejecimiento <= 0) {
+        return -1;
+      }
+    } else if (escenarioPalabra(l, "etapa")) {
+      long long tarea = escenarioLeerEntero(l), bahias = escenarioLeerEntero(l), cola = escenarioLeerEntero(l);
+      if (tarea < 1 || tarea > MAX_TAREAS || bahias < 1 || cola == 0) {
+        return -1;
+      }
+      e->bahiasEtapa[tarea - 1] = (int)bahias;
+      e->colaEtapa[tarea - 1] = cola > 0 ? (int)cola : 0;
+    } else if (escenarioPalabra(l, "depende")) {
+      long long tarea = escenarioLeerEntero(l), antes;
+      if (tarea < 1 || tarea > MAX_TAREAS) {
+        return -1;
+      }
+      while ((antes = escenarioLeerEntero(l)) >= 0) {
+        if (antes < 1 || antes >= tarea) {
+          return -1;
+        }
+        e->requisitos[tarea - 1] |= 1u << (antes - 1);
+      }
+    } else if (escenarioPalabra(l, "llegadas")) {
+      if (escenarioPalabra(l, "poisson")) {
+        e->llegadas = LLEGADAS_POISSON;
+      } else if (escenarioPalabra(l, "rafagas")) {
+        e->llegadas = LLEGADAS_RAFAGAS;
+      } else if (escenarioPalabra(l, "diurna")) {
+        e->llegadas = LLEGADAS_DIURNAS;
+      } else {
+        return -1;
+      }
+      if (escenarioLeerReal(l, &e->tasaLlegadas) != 0 || e->tasaLlegadas <= 0) {
+        return -1;
+      }
+      if (e->llegadas != LLEGADAS_POISSON &&
+          (escenarioLeerReal(l, &e->parametroLlegadas) != 0 || e->parametroLlegadas <= 0)) {
+        return -1;
+      }
+    } else if (escenarioPalabra(l, "sala")) {
+      long long capacidad = escenarioLeerEntero(l);
+      if (capacidad < 1) {
+        return -1;
+      }
+      e->capacidadSala = (int)capacidad;
+      if (escenarioPalabra(l, "rechazar")) {
+        e->politicaSala = SALA_RECHAZAR;
+      } else if (escenarioPalabra(l, "descartar")) {
+        e->politicaSala = SALA_DESCARTAR;
+      } else {
+        escenarioPalabra(l, "bloquear"); // Es la de por defecto
+      }
+    } else {
+      return -1;
+    }
+    // Lo que quede en la línea tiene que ser un comentario
+    escenarioSaltarBlancos(l);
+    if (l->p < l->fin && *l->p != '\n' && *l->p != '#') {
+      return -1;
+    }
+    escenarioSaltarLinea(l);
+  }
+  // Los rangos se buscan por bisección, así que no pueden pisarse
+  qsort(e->perfiles, e->nPerfiles, sizeof(PerfilAutos), escenarioCompararPerfiles);
+  for (int i = 1; i < e->nPerfiles; i++) {
+    if (e->perfiles[i].desde <= e->perfiles[i - 1].hasta) {
+      return -1;
+    }
+  }
+  qsort(e->clases, e->nClases, sizeof(ClaseAutos), escenarioCompararClases);
+  for (int i = 1; i < e->nClases; i++) {
+    if (e->clases[i].desde <= e->clases[i - 1].hasta) {
+      return -1;
+    }
+  }
+  return e->nAutos >= 0 && e->nEstaciones > 0 && e->nTareas > 0 ? 0 : -1;
+}
+
+/* ---------------------------------------------------------
+Lee el archivo de configuración (de 3 números o de escenario).
+"tareasPrograma" y "duracionNs" son las tareas y la duración
+fija que se usan si el archivo no trae líneas "tarea".
+Devuelve -1 si no se pudo abrir o tiene un error.
+------------------------------------------------------------*/
+static inline int escenarioLeer(const char* ruta, Escenario* e, char* const* tareasPrograma, int nTareas,
+                         uint64_t duracionNs) {
+  memset(e, 0, sizeof(Escenario));
+  e->envejecimiento = 5.0;
+  e->nTareas = nTareas;
+  for (int i = 0; i < nTareas; i++) {
+    e->nombresTareas[i] = tareasPrograma[i];
+    e->duraciones[i].tipo = DURACION_FIJA;
+    e->duraciones[i].parametro1 = duracionNs / 1e9;
+  }
+
+  int fd = open(ruta, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  struct stat datos;
+  if (fstat(fd, &datos) != 0 || datos.st_size == 0) {
+    close(fd);
+    return -1;
+  }
+  const char* mapa = mmap(NULL, datos.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapa == MAP_FAILED) {
+    return -1;
+  }
+  posix_madvise((void*)mapa, datos.st_size, POSIX_MADV_SEQUENTIAL);
+
+  LectorEscenario l = {mapa, mapa + datos.st_size};
+  int resultado;
+  escenarioSaltarBlancos(&l);
+  while (l.p < l.fin && (*l.p == '\n' || *l.p == ' ')) {
+    l.p++;
+  }
+  if (l.p < l.fin && *l.p >= '0' && *l.p <= '9') {
+    // Formato de siempre: nAutos, nEstaciones y capacidadXEstacion
+    long long autos = escenarioLeerEntero(&l);
+    while (l.p < l.fin && (*l.p == '\n' || *l.p == '\r')) l.p++;
+    long long estaciones = escenarioLeerEntero(&l);
+    while (l.p < l.fin && (*l.p == '\n' || *l.p == '\r')) l.p++;
+    long long capacidad = escenarioLeerEntero(&l);
+    int reservadas = 0;
+    e->nAutos = (int)autos;
+    resultado = autos < 0 || estaciones <= 0 || capacidad < 0 ? -1
+        : escenarioAgregarEstaciones(e, &reservadas, (int)capacidad, estaciones);
+  } else {
+    resultado = escenarioInterpretar(&l, e);
+  }
+  munmap((void*)mapa, datos.st_size);
+  return resultado;
+}
+
+// 1 si el auto hace la tarea (según el perfil que le toca; sin perfil hace todas)
+static inline int escenarioHaceTarea(const Escenario* e, int indiceAuto, int tarea) {
+  int bajo = 0, alto = e->nPerfiles - 1;
+  while (bajo <= alto) {
+    int medio = (bajo + alto) / 2;
+    const PerfilAutos* perfil = &e->perfiles[medio];
+    if (indiceAuto < perfil->desde) {
+      alto = medio - 1;
+    } else if (indiceAuto > perfil->hasta) {
+      bajo = medio + 1;
+    } else {
+      return (perfil->tareas >> tarea) & 1;
+    }
+  }
+  return 1;
+}
+
+// Clase de prioridad del auto (CLASE_*; los que no están en ninguna son particulares)
+static int escenarioClaseDeAuto(const Escenario* e, int indiceAuto) {
+  int bajo = 0, alto = e->nClases - 1;
+  while (bajo <= alto) {
+    int medio = (bajo + alto) / 2;
+    const ClaseAutos* clase = &e->clases[medio];
+    if (indiceAuto < clase->desde) {
+      alto = medio - 1;
+    } else if (indiceAuto > clase->hasta) {
+      bajo = medio + 1;
+    } else {
+      return clase->clase;
+    }
+  }
+  return CLASE_PARTICULAR;
+}
+
+// Mezcla de splitmix64: de un número cualquiera saca 64 bits bien repartidos
+static inline uint64_t escenarioMezclar(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+// Número aleatorio en (0, 1) con xorshift64* sobre "estado" (nunca 0)
+static double escenarioAzar(uint64_t* estado) {
+  *estado ^= *estado >> 12;
+  *estado ^= *estado << 25;
+  *estado ^= *estado >> 27;
+  return ((*estado * 0x2545F4914F6CDD1Dull >> 11) + 0.5) / 9007199254740992.0;
+}
+
+// Estado inicial de los sorteos de una corriente (por ejemplo, la tarea de un auto):
+// solo depende de la semilla y de "corriente", no del hilo ni del orden en que se sortea
+static inline uint64_t escenarioSembrar(const Escenario* e, uint64_t corriente) {
+  uint64_t estado = escenarioMezclar(escenarioMezclar(e->semilla) ^ corriente);
+  return estado ? estado : 1;
+}
+
+/* ---------------------------------------------------------
+Sortea cuánto dura la tarea del auto "indiceAuto", en
+nanosegundos. Con la misma semilla el auto saca siempre la
+misma duración para cada tarea, corra en el hilo que corra y
+con la estrategia que sea.
+------------------------------------------------------------*/
+static inline uint64_t escenarioDuracionNs(const Escenario* e, int indiceAuto, int tarea) {
+  const DuracionTarea* d = &e->duraciones[tarea];
+  uint64_t estado = escenarioSembrar(e, (uint64_t)indiceAuto * MAX_TAREAS + tarea);
+  double segundos;
+  switch (d->tipo) {
+  case DURACION_EXPONENCIAL:
+    segundos = -d->parametro1 * log(escenarioAzar(&estado));
+    break;
+  case DURACION_LOGNORMAL: {
+    // Box-Muller: una normal estándar a partir de dos uniformes
+    double radio = sqrt(-2.0 * log(escenarioAzar(&estado)));
+    double normal = radio * cos(6.283185307179586 * escenarioAzar(&estado));
+    segundos = exp(d->parametro1 + d->parametro2 * normal);
+    break;
+  }
+  default:
+    segundos = d->parametro1;
+  }
+  return segundos > 0 ? (uint64_t)(segundos * 1e9) : 0;
+}
+
+// Duerme el hilo "ns" nanosegundos (reemplaza al sleep(1) de cada tarea)
+static inline void dormirNs(uint64_t ns) {
+  if (ns == 0) {
+    return;
+  }
+  struct timespec t = {(time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull)};
+  while (nanosleep(&t, &t) != 0) {
+  }
+}
+
+static inline void escenarioDestruir(Escenario* e) {
+  if (e->nombresPropios) {
+    for (int i = 0; i < e->nTareas; i++) {
+      free(e->nombresTareas[i]);
+    }
+  }
+  free(e->capacidades);
+  free(e->perfiles);
+  free(e->clases);
+}
+
+#endif
@@ -0,0 +1,91 @@
+// ESPERA ADAPTATIVA: GIRAR UN POCO Y DESPUÉS DORMIR EN UN FUTEX
+//
+// Las variantes de espera activa reintentaban con usleep(1000) o usleep(100000):
+// cada reintento podía sumar hasta 100 ms de demora aunque la plaza se hubiera
+// liberado enseguida, y con cientos de autos los despertares periódicos se comían
+// varios núcleos. Acá el auto primero gira un rato corto (con la instrucción de
+// pausa del procesador) mirando si algo cambió y, si no, se duerme en un futex
+// hasta que quien libera una plaza lo despierte.
+//
+// Cuántas vueltas gira se adapta solo: si girando suele ver el cambio, gira más
+// (hasta GIROS_MAXIMOS); si casi siempre termina durmiendo igual (por ejemplo con
+// un solo núcleo, donde nadie puede liberar mientras giramos), gira cada vez menos.
+
+#ifndef ESPERA_ADAPTATIVA_H
+#define ESPERA_ADAPTATIVA_H
+
+#include <stdatomic.h> // Para atomic_int
+#include "futex.h"     // Para futexEsperar, futexDespertar
+
+#define GIROS_INICIALES 100
+#define GIROS_MINIMOS   4
+#define GIROS_MAXIMOS   4000
+
+// Le avisa al procesador que estamos girando (libera recursos para el otro hilo del núcleo)
+static inline void pausaCpu(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+/* ---------------------------------------------------------
+Gira hasta "*giros" vueltas mientras *palabra siga valiendo
+"valor". Devuelve 1 si cambió mientras giraba y ajusta
+"*giros" para la próxima vez (más si sirvió, menos si no).
+------------------------------------------------------------*/
+static inline int esperaAdaptativaGirar(atomic_int* palabra, int valor, atomic_int* giros) {
+  int limite = atomic_load_explicit(giros, memory_order_relaxed);
+  for (int i = 0; i < limite; i++) {
+    if (atomic_load_explicit(palabra, memory_order_acquire) != valor) {
+      if (limite < GIROS_MAXIMOS) {
+        atomic_store_explicit(giros, 2 * limite, memory_order_relaxed);
+      }
+      return 1;
+    }
+    pausaCpu();
+  }
+  if (limite > GIROS_MINIMOS) {
+    atomic_store_explicit(giros, limite / 2, memory_order_relaxed);
+  }
+  return 0;
+}
+
+// Aviso de "algo cambió" (por ejemplo, se liberó una plaza) que se puede esperar
+typedef struct {
+  atomic_int secuencia; // Sube en 1 con cada aviso; es la palabra del futex
+  atomic_int dormidos;  // Hilos bloqueados en el futex (para no despertar en vano)
+  atomic_int giros;     // Vueltas que conviene girar antes de dormir
+} Aviso;
+
+#define AVISO_INICIAL {0, 0, GIROS_INICIALES}
+
+/* ---------------------------------------------------------
+Uso (así no se pierde un aviso que llega entre probar y dormir):
+    int ticket = avisoTicket(&aviso);
+    if (!probar()) avisoEsperar(&aviso, ticket);
+------------------------------------------------------------*/
+static inline int avisoTicket(Aviso* a) {
+  return atomic_load(&a->secuencia);
+}
+
+// Gira y, si no hubo avisos desde "ticket", duerme hasta el próximo. Puede volver antes.
+static inline void avisoEsperar(Aviso* a, int ticket) {
+  if (esperaAdaptativaGirar(&a->secuencia, ticket, &a->giros)) {
+    return;
+  }
+  atomic_fetch_add(&a->dormidos, 1);
+  futexEsperar(&a->secuencia, ticket); // Vuelve enseguida si secuencia ya cambió
+  atomic_fetch_sub(&a->dormidos, 1);
+}
+
+// Avisa un cambio y despierta a un solo hilo dormido (si hay alguno)
+static inline void avisoDespertarUno(Aviso* a) {
+  atomic_fetch_add(&a->secuencia, 1);
+  if (atomic_load(&a->dormidos) > 0) {
+    futexDespertar(&a->secuencia, 1);
+  }
+}
+
+#endif
@@ -0,0 +1,74 @@
+// ASIGNADOR DE PLAZAS SIN CANDADOS (LOCK-FREE)
+//
+// Cada estación tiene un contador atómico de plazas libres. Tomar una plaza es un
+// compare-and-swap que lo baja en 1 solo si sigue siendo > 0; liberarla es una suma
+// atómica. Ningún auto toma el mutex global para entrar o salir de una estación.
+// Cada contador va solo en su línea de caché: el CAS sobre una estación no invalida
+// las vecinas (ver lineaCache.h).
+
+#ifndef ESTACIONES_ATOMICAS_H
+#define ESTACIONES_ATOMICAS_H
+
+#include <stdatomic.h> // Para atomic_int, atomic_compare_exchange_weak
+#include "afinidad.h"  // Para afinidadReservar (contadores en el nodo de su estación)
+#include "lineaCache.h" // Para PlazasAtomicas
+#include "politicas.h" // Para politicaTomar
+
+typedef struct {
+  PlazasAtomicas* plazasLibres; // plazasLibres[i].libres = plazas libres de la estación i+1
+  int nEstaciones;
+} EstacionesAtomicas;
+
+// Reserva los contadores y deja cada uno en su capacidad. Devuelve -1 si no hay memoria.
+static int estacionesAtomicasIniciar(EstacionesAtomicas* e, int nEstaciones, const int* capacidades) {
+  e->nEstaciones = nEstaciones;
+  e->plazasLibres = afinidadReservar(nEstaciones, sizeof(PlazasAtomicas));
+  if (!e->plazasLibres) {
+    return -1;
+  }
+  for (int i = 0; i < nEstaciones; i++) {
+    atomic_init(&e->plazasLibres[i].libres, capacidades[i]);
+  }
+  return 0;
+}
+
+static void estacionesAtomicasDestruir(EstacionesAtomicas* e) {
+  afinidadLiberar(e->plazasLibres, e->nEstaciones, sizeof(PlazasAtomicas));
+}
+
+/* ---------------------------------------------------------
+Intenta ocupar una plaza en la estación i (0..n-1) con CAS.
+Devuelve 1 si la ocupó o 0 si la estación está llena.
+------------------------------------------------------------*/
+static inline int estacionesAtomicasTomarEn(EstacionesAtomicas* e, int i) {
+  int libres = atomic_load_explicit(&e->plazasLibres[i].libres, memory_order_relaxed);
+  while (libres > 0) {
+    // Si otro auto cambió el contador entre medio, el CAS falla y recarga "libres"
+    if (atomic_compare_exchange_weak_explicit(&e->plazasLibres[i].libres, &libres, libres - 1,
+                                              memory_order_acquire, memory_order_relaxed)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Plazas libres de la estación i (0..n-1), para que la política elija
+static int estacionesAtomicasLibresEn(void* e, int i) {
+  return atomic_load_explicit(&((EstacionesAtomicas*)e)->plazasLibres[i].libres, memory_order_relaxed);
+}
+
+static int estacionesAtomicasOcuparEn(void* e, int i) {
+  return estacionesAtomicasTomarEn((EstacionesAtomicas*)e, i);
+}
+
+// Elige estación con la política (ver politicas.h) y devuelve la asignada (1..n) o -1
+static inline int estacionesAtomicasTomar(EstacionesAtomicas* e, int politica) {
+  return politicaTomar(politica, e->nEstaciones, estacionesAtomicasLibresEn, estacionesAtomicasOcuparEn, e);
+}
+
+// Devuelve la plaza de la estación "estacion" (1..n)
+static inline void estacionesAtomicasLiberar(EstacionesAtomicas* e, int estacion) {
+  atomic_fetch_add_explicit(&e->plazasLibres[estacion - 1].libres, 1, memory_order_release);
+}
+
+#endif
@@ -0,0 +1,212 @@
+// FIBRAS SIN PILA EN ESPACIO DE USUARIO (CORRUTINAS) SOBRE POCOS HILOS DEL SISTEMA
+//
+// Cada fibra es un struct chico con una función que se puede retomar donde quedó:
+// las macros FIBRA_* guardan el punto de retorno (__LINE__) y al volver a llamar a
+// la función un switch salta ahí. No hay pila propia, así que las variables que
+// tienen que sobrevivir a una espera van en el struct de la fibra, no en locales.
+// Un millón de autos esperando ocupan un millón de structs, no un millón de pilas.
+//
+// Unos pocos hilos trabajadores sacan fibras de una cola de listas y las corren
+// hasta que ceden, se duermen (agenda por hora de despertar) o se bloquean (alguien
+// las vuelve a poner en la cola con fibrasDespertar).
+//
+// Este archivo solo tiene cabeceras y funciones static para que cada programa se
+// siga compilando solo con "gcc -pthread programa.c -lm".
+
+#ifndef FIBRAS_H
+#define FIBRAS_H
+
+#include <pthread.h>  // Para los hilos trabajadores, el mutex y la condición
+#include <stdint.h>   // Para uint64_t
+#include <stdlib.h>   // Para malloc, realloc, free
+#include <time.h>     // Para struct timespec
+#include "afinidad.h" // Para fijar los hilos trabajadores (--afinidad)
+#include "registro.h" // Para relojNs
+
+// Lo que devuelve la función de una fibra al planificador
+enum { FIBRA_LISTA, FIBRA_DORMIDA, FIBRA_BLOQUEADA, FIBRA_TERMINADA };
+
+typedef struct Fibra {
+  int (*rutina)(struct Fibra*); // Se llama cada vez que la fibra tiene que avanzar
+  int punto;                    // Dónde retomar (0 = desde el principio)
+  uint64_t despertarNs;         // Hora de despertar si está dormida
+  struct Fibra* siguiente;      // Cola de listas o cola de espera de quien la bloqueó
+} Fibra;
+
+// Cuerpo de la rutina de una fibra: FIBRA_INICIO(f) ... FIBRA_FIN(f);
+#define FIBRA_INICIO(f) switch ((f)->punto) { case 0:
+#define FIBRA_FIN(f) } (f)->punto = -1; return FIBRA_TERMINADA
+
+// Vuelve a la cola de listas y deja correr a las demás
+#define FIBRA_CEDER(f) \
+  do { (f)->punto = __LINE__; return FIBRA_LISTA; \
+       __attribute__((fallthrough)); case __LINE__:; } while (0)
+
+// Duerme "ns" nanosegundos sin ocupar el hilo
+#define FIBRA_DORMIR(f, ns) \
+  do { (f)->despertarNs = relojNs() + (ns); (f)->punto = __LINE__; return FIBRA_DORMIDA; \
+       __attribute__((fallthrough)); case __LINE__:; } while (0)
+
+// Evalúa "seBloqueo" con el punto de retorno ya guardado: si da distinto de 0 la fibra
+// quedó anotada en alguna espera y se suelta (otro hilo puede retomarla apenas la
+// despierten, incluso antes de que esta llamada termine de volver)
+#define FIBRA_ESPERAR_SI(f, seBloqueo) \
+  do { (f)->punto = __LINE__; if (seBloqueo) return FIBRA_BLOQUEADA; \
+       __attribute__((fallthrough)); case __LINE__:; } while (0)
+
+typedef struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t hayTrabajo;  // Con reloj monótono, para esperar a la próxima dormida
+  Fibra* primera;             // Cola FIFO de fibras listas
+  Fibra* ultima;
+  Fibra** dormidas;           // Heap mínimo por despertarNs
+  int nDormidas, capacidadDormidas;
+  long long vivas;            // Fibras que todavía no terminaron
+} Planificador;
+
+static Planificador planificador = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+
+// Pone la fibra al final de la cola de listas (con el mutex del planificador tomado)
+static void fibrasEncolar(Fibra* f) {
+  f->siguiente = NULL;
+  if (planificador.ultima) {
+    planificador.ultima->siguiente = f;
+  } else {
+    planificador.primera = f;
+  }
+  planificador.ultima = f;
+}
+
+// Agrega una fibra dormida al heap (con el mutex tomado). Sin memoria la deja lista.
+static void fibrasAgendar(Fibra* f) {
+  if (planificador.nDormidas == planificador.capacidadDormidas) {
+    int capacidad = planificador.capacidadDormidas ? 2 * planificador.capacidadDormidas : 1024;
+    Fibra** dormidas = realloc(planificador.dormidas, sizeof(Fibra*) * capacidad);
+    if (!dormidas) {
+      fibrasEncolar(f); // Se despierta antes de tiempo y se volverá a dormir
+      return;
+    }
+    planificador.dormidas = dormidas;
+    planificador.capacidadDormidas = capacidad;
+  }
+  int i = planificador.nDormidas++;
+  while (i > 0 && planificador.dormidas[(i - 1) / 2]->despertarNs > f->despertarNs) {
+    planificador.dormidas[i] = planificador.dormidas[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  planificador.dormidas[i] = f;
+}
+
+// Pasa a la cola de listas las fibras dormidas cuya hora ya llegó (con el mutex tomado)
+static void fibrasDespertarDormidas(uint64_t ahora) {
+  while (planificador.nDormidas > 0 && planificador.dormidas[0]->despertarNs <= ahora) {
+    fibrasEncolar(planificador.dormidas[0]);
+    Fibra* ultima = planificador.dormidas[--planificador.nDormidas];
+    int i = 0;
+    while (2 * i + 1 < planificador.nDormidas) {
+      int hijo = 2 * i + 1;
+      if (hijo + 1 < planificador.nDormidas &&
+          planificador.dormidas[hijo + 1]->despertarNs < planificador.dormidas[hijo]->despertarNs) {
+        hijo++;
+      }
+      if (ultima->despertarNs <= planificador.dormidas[hijo]->despertarNs) {
+        break;
+      }
+      planificador.dormidas[i] = planificador.dormidas[hijo];
+      i = hijo;
+    }
+    planificador.dormidas[i] = ultima;
+  }
+}
+
+// Vuelve a poner en la cola de listas una fibra bloqueada (o una nueva)
+static void fibrasDespertar(Fibra* f) {
+  pthread_mutex_lock(&planificador.mutex);
+  fibrasEncolar(f);
+  pthread_cond_signal(&planificador.hayTrabajo);
+  pthread_mutex_unlock(&planificador.mutex);
+}
+
+/* ---------------------------------------------------------
+Cada hilo trabajador saca fibras listas y las corre. Si no
+hay ninguna, espera a que alguien despierte una o a la hora
+de la próxima dormida. Termina cuando no quedan fibras vivas.
+------------------------------------------------------------*/
+static void* fibrasTrabajadorRoutine(void* arg) {
+  (void)arg;
+  afinidadFijarHilo(); // Con --afinidad, al núcleo de una estación (en ronda)
+  pthread_mutex_lock(&planificador.mutex);
+  while (planificador.vivas > 0) {
+    fibrasDespertarDormidas(relojNs());
+    Fibra* f = planificador.primera;
+    if (!f) {
+      if (planificador.nDormidas == 0) {
+        pthread_cond_wait(&planificador.hayTrabajo, &planificador.mutex);
+      } else {
+        uint64_t hasta = planificador.dormidas[0]->despertarNs;
+        struct timespec t = {(time_t)(hasta / 1000000000ull), (long)(hasta % 1000000000ull)};
+        pthread_cond_timedwait(&planificador.hayTrabajo, &planificador.mutex, &t);
+      }
+      continue;
+    }
+    planificador.primera = f->siguiente;
+    if (!planificador.primera) {
+      planificador.ultima = NULL;
+    }
+    pthread_mutex_unlock(&planificador.mutex);
+
+    int estado = f->rutina(f);
+
+    pthread_mutex_lock(&planificador.mutex);
+    if (estado == FIBRA_LISTA) {
+      fibrasEncolar(f);
+    } else if (estado == FIBRA_DORMIDA) {
+      fibrasAgendar(f);
+    } else if (estado == FIBRA_TERMINADA && --planificador.vivas == 0) {
+      pthread_cond_broadcast(&planificador.hayTrabajo); // Que salgan los demás hilos
+    }
+    // FIBRA_BLOQUEADA: ya no es nuestra, no se toca
+  }
+  pthread_mutex_unlock(&planificador.mutex);
+  return NULL;
+}
+
+// Prepara el planificador (llamar antes de agregar la primera fibra)
+static void fibrasIniciar(void) {
+  pthread_condattr_t atributos;
+  pthread_condattr_init(&atributos);
+  pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC); // Igual que relojNs
+  pthread_cond_init(&planificador.hayTrabajo, &atributos);
+  pthread_condattr_destroy(&atributos);
+}
+
+/* ---------------------------------------------------------
+Corre las "nFibras" fibras (ya agregadas con fibrasDespertar)
+sobre "nHilos" hilos trabajadores y vuelve cuando terminaron
+todas. Devuelve -1 si no se pudo crear ningún hilo.
+------------------------------------------------------------*/
+static int fibrasCorrer(int nHilos, long long nFibras) {
+  pthread_mutex_lock(&planificador.mutex);
+  planificador.vivas = nFibras;
+  pthread_mutex_unlock(&planificador.mutex);
+
+  pthread_t* hilos = malloc(sizeof(pthread_t) * nHilos);
+  if (!hilos) {
+    return -1;
+  }
+  int creados = 0;
+  for (int i = 0; i < nHilos; i++) {
+    if (pthread_create(&hilos[creados], NULL, fibrasTrabajadorRoutine, NULL) == 0) {
+      creados++;
+    }
+  }
+  for (int i = 0; i < creados; i++) {
+    pthread_join(hilos[i], NULL);
+  }
+  free(hilos);
+  free(planificador.dormidas);
+  pthread_cond_destroy(&planificador.hayTrabajo);
+  return creados > 0 ? 0 : -1;
+}
+
+#endif
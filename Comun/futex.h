@@ -0,0 +1,30 @@
+// FUTEX: ESPERA Y DESPERTAR SOBRE UNA PALABRA DE MEMORIA (SOLO LINUX)
+//
+// Es la primitiva que usan por dentro los mutex y semáforos de glibc. La usamos
+// directamente cuando queremos despertar a un hilo concreto y no a todos.
+
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <linux/futex.h> // Para FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <stdatomic.h>   // Para atomic_int
+#include <sys/syscall.h> // Para SYS_futex
+
+// Con _XOPEN_SOURCE 600 unistd.h no declara syscall(), así que la declaramos aquí
+long syscall(long numero, ...);
+
+/* ---------------------------------------------------------
+Bloquea al hilo mientras *direccion siga valiendo "valor".
+Puede volver antes de tiempo (señales, despertares espurios):
+quien llama siempre debe volver a comprobar su condición.
+------------------------------------------------------------*/
+static inline void futexEsperar(atomic_int* direccion, int valor) {
+  syscall(SYS_futex, (int*)direccion, FUTEX_WAIT_PRIVATE, valor, NULL, NULL, 0);
+}
+
+// Despierta hasta "cantidad" hilos bloqueados en direccion
+static inline void futexDespertar(atomic_int* direccion, int cantidad) {
+  syscall(SYS_futex, (int*)direccion, FUTEX_WAKE_PRIVATE, cantidad, NULL, NULL, 0);
+}
+
+#endif
@@ -0,0 +1,196 @@
+// LATENCIA DE CADA FASE DEL AUTO (--latencias)
+//
+// Con --politica solo se sabe cuánto esperó cada auto para entrar; el tiempo total
+// se medía desde afuera (scriptMetricas.py). Con --latencias cada auto anota con el
+// reloj monótono cuánto duró cada fase de su recorrido:
+//
+//   turno     Hasta que le tocó el turno (solo con entrada ordenada).
+//   estación  Hasta que consiguió plaza.
+//   <tarea>   Cada tarea de su perfil (incluye registrar sus eventos).
+//   salida    Devolver la plaza o pasársela a otro.
+//
+// Cada duración va a un histograma tipo HDR: 16 cubetas por cada potencia de 2 de
+// nanosegundos (como mucho un 6,25% de error), hasta 2^41 ns (unos 36 minutos).
+// Para que anotar no sea un punto de contención, los hilos no comparten un único
+// histograma: hay FRAGMENTOS_LATENCIA copias y cada hilo usa siempre la misma (no
+// una por hilo, porque con un hilo por auto serían miles). Al final se suman las
+// copias y se imprime p50, p90, p99, p99.9 y el máximo de cada fase. Anotar una
+// fase es una lectura del reloj y dos sumas atómicas relajadas.
+
+#ifndef LATENCIAS_H
+#define LATENCIAS_H
+
+#include <math.h>      // Para fmin
+#include <stdatomic.h> // Para los contadores de las cubetas
+#include <stdint.h>    // Para uint64_t
+#include <stdio.h>     // Para printf, snprintf
+#include <stdlib.h>    // Para calloc, free
+#include "registro.h"  // Para relojNs
+
+// Fases fijas; la tarea i del escenario es la fase FASE_PRIMERA_TAREA + i
+enum { FASE_TURNO, FASE_ESTACION, FASE_SALIDA, FASE_PRIMERA_TAREA };
+
+#define SUBCUBETAS_LATENCIA 16 // Cubetas por cada potencia de 2
+#define POTENCIA_MAXIMA_LATENCIA 40 // Lo que dura más de 2^41 ns va a la última cubeta
+#define CUBETAS_LATENCIA (SUBCUBETAS_LATENCIA * (POTENCIA_MAXIMA_LATENCIA - 2))
+#define FRAGMENTOS_LATENCIA 16 // Copias del histograma repartidas entre los hilos
+
+typedef struct {
+  int activas;                // 0 = no se mide nada (sin --latencias)
+  int nFases;
+  char* const* nombresTareas; // Para imprimir las fases de las tareas
+  atomic_llong* cuentas;      // [fragmento][fase][cubeta]
+  atomic_ullong* maximos;     // [fragmento][fase]: la duración más larga, exacta
+  atomic_int siguienteFragmento;
+} Latencias;
+
+static Latencias latencias;
+
+// Fragmento que usa este hilo (se le asigna la primera vez que anota algo)
+static _Thread_local int fragmentoDelHilo = -1;
+
+/* ---------------------------------------------------------
+Empieza a medir las fases (llamar antes de crear los hilos).
+Devuelve -1 si no hay memoria.
+------------------------------------------------------------*/
+static inline int latenciasIniciar(int nTareas, char* const* nombresTareas) {
+  latencias.nFases = FASE_PRIMERA_TAREA + nTareas;
+  latencias.nombresTareas = nombresTareas;
+  size_t fasesTotales = (size_t)FRAGMENTOS_LATENCIA * latencias.nFases;
+  latencias.cuentas = calloc(fasesTotales * CUBETAS_LATENCIA, sizeof(atomic_llong));
+  latencias.maximos = calloc(fasesTotales, sizeof(atomic_ullong));
+  if (!latencias.cuentas || !latencias.maximos) {
+    free(latencias.cuentas);
+    free(latencias.maximos);
+    return -1;
+  }
+  atomic_init(&latencias.siguienteFragmento, 0);
+  latencias.activas = 1;
+  return 0;
+}
+
+// Cubeta del histograma para una duración de "ns" nanosegundos
+static int cubetaLatencia(uint64_t ns) {
+  if (ns < SUBCUBETAS_LATENCIA) {
+    return (int)ns;
+  }
+  int potencia = 63 - __builtin_clzll(ns);
+  if (potencia > POTENCIA_MAXIMA_LATENCIA) {
+    return CUBETAS_LATENCIA - 1;
+  }
+  return SUBCUBETAS_LATENCIA * (potencia - 3) + (int)((ns >> (potencia - 4)) & (SUBCUBETAS_LATENCIA - 1));
+}
+
+// Mayor duración (en ns) que cae en la cubeta "c"
+static uint64_t finCubetaLatencia(int c) {
+  if (c < SUBCUBETAS_LATENCIA) {
+    return (uint64_t)c;
+  }
+  int potencia = c / SUBCUBETAS_LATENCIA + 3;
+  return ((uint64_t)(SUBCUBETAS_LATENCIA + c % SUBCUBETAS_LATENCIA + 1) << (potencia - 4)) - 1;
+}
+
+// Suma "ns" al histograma "cuentas" (CUBETAS_LATENCIA cubetas) y actualiza su máximo
+static void latenciasAnotarEn(atomic_llong* cuentas, atomic_ullong* maximo, uint64_t ns) {
+  atomic_fetch_add_explicit(&cuentas[cubetaLatencia(ns)], 1, memory_order_relaxed);
+  unsigned long long anterior = atomic_load_explicit(maximo, memory_order_relaxed);
+  while (ns > anterior &&
+         !atomic_compare_exchange_weak_explicit(maximo, &anterior, ns, memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+// Anota que la fase "fase" duró "ns" nanosegundos
+static void latenciasAnotar(int fase, uint64_t ns) {
+  if (fragmentoDelHilo < 0) {
+    fragmentoDelHilo = atomic_fetch_add(&latencias.siguienteFragmento, 1) % FRAGMENTOS_LATENCIA;
+  }
+  size_t f = (size_t)fragmentoDelHilo * latencias.nFases + fase;
+  latenciasAnotarEn(&latencias.cuentas[f * CUBETAS_LATENCIA], &latencias.maximos[f], ns);
+}
+
+/* ---------------------------------------------------------
+Cierra la fase "fase": anota el tiempo desde *marcaNs hasta
+ahora y deja la marca en ahora para la fase siguiente. Sin
+--latencias no lee el reloj.
+------------------------------------------------------------*/
+static inline void latenciasMarcar(int fase, uint64_t* marcaNs) {
+  if (!latencias.activas) {
+    return;
+  }
+  uint64_t ahora = relojNs();
+  latenciasAnotar(fase, ahora - *marcaNs);
+  *marcaNs = ahora;
+}
+
+// Duración (en segundos) por debajo de la cual quedó la fracción "q" de las "n"
+static double latenciasPercentil(const long long* cuentas, long long n, double q) {
+  long long acumuladas = 0;
+  for (int c = 0; c < CUBETAS_LATENCIA; c++) {
+    acumuladas += cuentas[c];
+    if (acumuladas >= q * n) {
+      return finCubetaLatencia(c) / 1e9;
+    }
+  }
+  return 0;
+}
+
+/* ---------------------------------------------------------
+Imprime "<titulo>: p50 ..., máxima ... (n autos)" con los
+percentiles del histograma "cuentas" de "n" duraciones.
+------------------------------------------------------------*/
+static void latenciasImprimirLinea(const char* titulo, const long long* cuentas, long long n, uint64_t maximo) {
+  // Los percentiles salen del fin de su cubeta: nunca se pasan del máximo real
+  double m = maximo / 1e9;
+  printf("%s: p50 %.6f s, p90 %.6f s, p99 %.6f s, p99.9 %.6f s, máxima %.6f s (%lld autos)\n", titulo,
+         fmin(latenciasPercentil(cuentas, n, 0.5), m), fmin(latenciasPercentil(cuentas, n, 0.9), m),
+         fmin(latenciasPercentil(cuentas, n, 0.99), m), fmin(latenciasPercentil(cuentas, n, 0.999), m), m, n);
+}
+
+/* ---------------------------------------------------------
+Suma los fragmentos e imprime una línea por fase con sus
+percentiles (llamar después de que terminaron los hilos).
+Las fases que nadie hizo no se imprimen.
+------------------------------------------------------------*/
+static inline void latenciasImprimir(void) {
+  if (!latencias.activas) {
+    return;
+  }
+  for (int fase = 0; fase < latencias.nFases; fase++) {
+    // Se imprimen en el orden del recorrido: turno, estación, las tareas y al final la salida
+    int f = fase < FASE_SALIDA ? fase : fase == latencias.nFases - 1 ? FASE_SALIDA : fase + 1;
+    long long cuentas[CUBETAS_LATENCIA] = {0};
+    long long n = 0;
+    uint64_t maximo = 0;
+    for (int k = 0; k < FRAGMENTOS_LATENCIA; k++) {
+      size_t i = (size_t)k * latencias.nFases + f;
+      for (int c = 0; c < CUBETAS_LATENCIA; c++) {
+        long long cuenta = atomic_load_explicit(&latencias.cuentas[i * CUBETAS_LATENCIA + c], memory_order_relaxed);
+        cuentas[c] += cuenta;
+        n += cuenta;
+      }
+      uint64_t m = atomic_load_explicit(&latencias.maximos[i], memory_order_relaxed);
+      maximo = m > maximo ? m : maximo;
+    }
+    if (n == 0) {
+      continue;
+    }
+    const char* nombre = f >= FASE_PRIMERA_TAREA ? latencias.nombresTareas[f - FASE_PRIMERA_TAREA]
+                         : f == FASE_TURNO       ? "turno"
+                         : f == FASE_ESTACION    ? "estación"
+                                                 : "salida";
+    char titulo[128];
+    snprintf(titulo, sizeof(titulo), "Latencia %s", nombre);
+    latenciasImprimirLinea(titulo, cuentas, n, maximo);
+  }
+}
+
+static inline void latenciasDestruir(void) {
+  if (!latencias.activas) {
+    return;
+  }
+  free(latencias.cuentas);
+  free(latencias.maximos);
+  latencias.activas = 0;
+}
+
+#endif
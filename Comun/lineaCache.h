@@ -0,0 +1,44 @@
+// ESTADO DE CADA ESTACIÓN EN SU PROPIA LÍNEA DE CACHÉ
+//
+// Las plazas libres de las estaciones eran un int[] (o un sem_t[]) compacto: 16
+// estaciones por línea de 64 bytes (2 con semáforos). Cada vez que un auto entraba o
+// salía de una estación, la escritura invalidaba esa línea en los demás núcleos
+// aunque ellos estuvieran usando otra estación (falso compartir). Acá cada estación
+// ocupa su propia línea alineada:
+//
+//   PlazasEstacion    plazas libres de las variantes que las cuentan bajo un mutex
+//   SemaforoEstacion  el semáforo de la variante con semáforos
+//   PlazasAtomicas    el contador de plazas de --lockfree (estacionesAtomicas.h)
+//
+// Lo caliente (plazas, colas de espera) queda separado de lo frío: las métricas de
+// cada estación (politicas.h) van en otro array, también una línea por estación.
+// Benchmarks/benchmarkFalsoCompartir.c mide la diferencia con distintos hilos.
+//
+// Los arrays de estos tipos se reservan con afinidadReservar (afinidad.h), que los
+// devuelve alineados; malloc solo garantiza 16 bytes.
+
+#ifndef LINEA_CACHE_H
+#define LINEA_CACHE_H
+
+#include <semaphore.h> // Para sem_t
+#include <stdatomic.h> // Para atomic_int
+
+#define LINEA_CACHE 64
+
+typedef struct {
+  _Alignas(LINEA_CACHE) int plazasLibres;
+} PlazasEstacion;
+
+typedef struct {
+  _Alignas(LINEA_CACHE) sem_t semaforo;
+} SemaforoEstacion;
+
+typedef struct {
+  _Alignas(LINEA_CACHE) atomic_int libres;
+} PlazasAtomicas;
+
+_Static_assert(sizeof(PlazasEstacion) == LINEA_CACHE, "una estación por línea");
+_Static_assert(sizeof(SemaforoEstacion) == LINEA_CACHE, "un semáforo por línea");
+_Static_assert(sizeof(PlazasAtomicas) == LINEA_CACHE, "un contador por línea");
+
+#endif
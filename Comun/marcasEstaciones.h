@@ -0,0 +1,60 @@
+// MARCAS POR ESTACIÓN: UN BIT POR ESTACIÓN PARA NO RECORRERLAS TODAS
+//
+// La variante Colas necesita encontrar rápido "alguna estación con plaza libre" y
+// "alguna estación con autos en su cola". Recorrer las nEstaciones leyendo cada una
+// cuesta O(nEstaciones) por auto, y con los escenarios de 100000 estaciones eso es
+// lo que domina. Acá cada estación tiene un bit en un array de palabras de 64 bits:
+// quien cambia el estado de la estación (con su candado) pone o saca su bit, y quien
+// busca salta de a 64 estaciones las palabras en cero.
+//
+// Los bits son una pista: se leen sin candado, así que el que encuentra una estación
+// marcada tiene que volver a mirarla con su candado (puede que ya no tenga nada).
+// Poner y sacar son operaciones atómicas seq_cst para que, junto con otro contador
+// seq_cst, ningún auto quede esperando con una plaza libre (ver repartirPlazas).
+
+#ifndef MARCAS_ESTACIONES_H
+#define MARCAS_ESTACIONES_H
+
+#include <stdatomic.h> // Para las palabras de bits
+#include <stdint.h>    // Para uint64_t
+#include <stdlib.h>    // Para calloc, free
+
+typedef struct {
+  atomic_ullong* palabras; // Bit i % 64 de palabras[i / 64] = la estación i (0..n-1) está marcada
+  int nPalabras;
+} MarcasEstaciones;
+
+// Todas sin marcar. Devuelve -1 si no hay memoria.
+static int marcasIniciar(MarcasEstaciones* m, int nEstaciones) {
+  m->nPalabras = (nEstaciones + 63) / 64;
+  m->palabras = calloc(m->nPalabras > 0 ? m->nPalabras : 1, sizeof(atomic_ullong));
+  return m->palabras ? 0 : -1;
+}
+
+static void marcasDestruir(MarcasEstaciones* m) {
+  free(m->palabras);
+}
+
+static inline void marcasPoner(MarcasEstaciones* m, int i) {
+  atomic_fetch_or(&m->palabras[i / 64], 1ull << (i % 64));
+}
+
+static inline void marcasSacar(MarcasEstaciones* m, int i) {
+  atomic_fetch_and(&m->palabras[i / 64], ~(1ull << (i % 64)));
+}
+
+// Primera estación marcada desde "desde" (0..n-1) en adelante, o -1 si no hay ninguna
+static inline int marcasSiguiente(MarcasEstaciones* m, int desde) {
+  for (int p = desde / 64; p < m->nPalabras; p++) {
+    uint64_t bits = atomic_load(&m->palabras[p]);
+    if (p == desde / 64) {
+      bits &= ~0ull << (desde % 64);
+    }
+    if (bits) {
+      return p * 64 + __builtin_ctzll(bits);
+    }
+  }
+  return -1;
+}
+
+#endif
@@ -0,0 +1,241 @@
+// OPCIONES DE LÍNEA DE COMANDOS COMUNES A TODAS LAS VARIANTES
+//
+// Uso: ./programa mantenimientoConfig.txt [opciones]
+//
+//   --pool        En lugar de crear un hilo por auto, crea nEstaciones * capacidadXEstacion
+//                 hilos trabajadores que sacan autos de una cola de admisión compartida.
+//                 En todas menos Fibras.
+//   --lockfree    Las plazas de cada estación son contadores atómicos que se toman y
+//                 liberan con CAS, sin pasar por el mutex global (ver estacionesAtomicas.h).
+//                 Solo en las variantes semáforos, Espera y Barrera (en el motor es
+//                 --estrategia atomica).
+//   --log-async   Los mensajes se guardan en un anillo por hilo y los imprime un único
+//                 hilo escritor con write(2) por lotes (ver registro.h).
+//   --traza <archivo>  En vez de imprimir los mensajes, guarda cada evento en binario
+//                 (24 bytes) en el archivo. Se decodifica con Herramientas/decodificarTraza.py.
+//   --resumen     No imprime ni guarda los mensajes de cada auto: solo la línea del final
+//                 y los resúmenes (de --simulacion, --politica, --latencias, etc.). Sirve
+//                 para medir corridas de millones de autos sin escribir gigabytes de
+//                 texto. No se usa junto con --traza.
+//   --simulacion  No crea hilos ni hace sleep: corre el mismo modelo con un reloj virtual
+//                 y una agenda de eventos e imprime un resumen por estación (ver simulacion.h).
+//                 Solo en las variantes con sleep (Espera y Barrera).
+//   --politica <primera|turno|jsq|dos>  Cómo se elige la estación (ver politicas.h) y,
+//                 al final, un resumen de utilización y espera por estación. No cambia
+//                 nada en --simulacion (ahí cada plaza liberada pasa al siguiente en fila).
+//   --pestillo    Sin barrera al final: cada hilo termina (y libera su pila) apenas acaba
+//                 con sus autos y main espera en un único pestillo de cuenta regresiva
+//                 (ver pestillo.h). Solo en la variante Barrera y en el motor.
+//   --fases       Un pestillo por tarea que no frena a nadie: al final se imprime cuándo
+//                 terminaron todos los autos cada tarea. Solo en la variante Barrera.
+//   --latencias   Cada auto anota cuánto duró cada fase (turno, estación, cada tarea y
+//                 salida) y al final se imprimen sus percentiles (ver latencias.h).
+//                 No cambia nada en --simulacion.
+//   --tablero <nombre>  Publica contadores en vivo (autos llegados, esperando, en cada
+//                 estación, terminados y espera acumulada) en el segmento de memoria
+//                 compartida /dev/shm/<nombre> (ver tablero.h y Herramientas/leerTablero.py).
+//                 No cambia nada en --simulacion.
+//   --afinidad    Fija cada hilo al núcleo de una estación, deja el estado de cada
+//                 estación en la memoria de su nodo NUMA y hace que los autos prueben
+//                 primero las estaciones de su nodo (ver afinidad.h).
+//                 No cambia nada en --simulacion.
+//   --prioridades Cada auto tiene la clase que le da el escenario (flota, garantía o
+//                 particular) y las filas de espera atienden primero a las clases más
+//                 urgentes, con envejecimiento para que nadie se quede sin entrar. Al
+//                 final se imprimen los percentiles de espera y de tiempo total de cada
+//                 clase (ver prioridades.h). Solo reordena en las variantes con fila
+//                 (semáforos y Colas); en las demás solo mide. No cambia nada en --simulacion.
+//   --combinar    Los autos dejan sus pedidos de entrar y salir en una pila sin candado
+//                 y el que consigue el candado atiende todos los pendientes de una vez
+//                 (flat combining, ver combinador.h). Al final imprime cuántos pedidos
+//                 se atendieron por toma del candado. Solo en la variante Condicion (en
+//                 el motor es --estrategia combinada).
+//   --estrategia <nombre|todas>  Cómo consiguen y devuelven plaza los autos (semaforos,
+//                 condicion, espera, barrera, colas, atomica o combinada). Con "todas"
+//                 corre una después de otra en el mismo proceso e imprime cuánto tardó
+//                 cada una.
+//                 Solo en Motor/mantenimientoDeTeslasMotor.c (ver Motor/estrategia.h).
+//   --linea       Cada tarea es una etapa con sus propias bahías y los autos pasan de una
+//                 a otra por colas acotadas (ver Motor/lineaDeMontaje.h y la directiva
+//                 "etapa" de escenario.h). Al final imprime lo que atendió cada etapa por
+//                 segundo y la ocupación de sus bahías y de su cola. Con --estrategia
+//                 corre antes esa estrategia para comparar. --pool, --politica,
+//                 --latencias, --tablero y --prioridades no cambian nada en la línea.
+//                 Solo en Motor/mantenimientoDeTeslasMotor.c.
+//   --tecnicos <n>  Cada estación tiene n técnicos y las tareas de un auto que no dependen
+//                 unas de otras (directiva "depende" de escenario.h) se hacen al mismo
+//                 tiempo, cada una con un técnico libre (ver Motor/tecnicos.h). Al final
+//                 imprime el servicio medio por auto. Solo en Motor/mantenimientoDeTeslasMotor.c.
+//   --carga <f1,f2,...>  Con la directiva "llegadas" del escenario, repite cada corrida con
+//                 la tasa de llegadas multiplicada por cada factor e imprime la carga
+//                 ofrecida contra la espera y el tiempo total (ver Motor/llegadas.h).
+//                 Solo en Motor/mantenimientoDeTeslasMotor.c.
+//   --entrada <ordenada|desordenada>  Si los autos entran respetando su número (como
+//                 en "Entrada Ordenada") o no. Solo en Motor/mantenimientoDeTeslasMotor.c.
+//   --fibras      Cada auto es una fibra sin pila y unos pocos hilos del sistema (uno por
+//                 CPU) las van corriendo (ver Motor/autosFibra.h). Solo en
+//                 Motor/mantenimientoDeTeslasMotor.c (en la variante Fibras va siempre).
+//
+// Cada programa le pasa a leerOpciones las OPCION_* que tiene y las demás se rechazan
+// con un error, en lugar de aceptarlas y no hacer nada.
+//
+// Este archivo solo tiene cabeceras y funciones static para que cada programa se
+// siga compilando solo con "gcc -pthread programa.c -lm" (como hace scriptMetricas.py;
+// -lm es por los tiempos aleatorios de escenario.h).
+
+#ifndef OPCIONES_H
+#define OPCIONES_H
+
+#include <stdio.h>  // Para fprintf
+#include <stdlib.h> // Para atoi
+#include <string.h> // Para strcmp, memset
+#include "politicas.h" // Para politicaPorNombre
+
+typedef struct {
+  int modoPool;           // 1 = pool fijo de hilos trabajadores, 0 = un hilo por auto (original)
+  int estacionesLockFree; // 1 = plazas con contadores atómicos, 0 = con mutex/semáforos (original)
+  int registroAsincrono;  // 1 = hilo escritor con anillos por hilo, 0 = printf bajo mutex (original)
+  const char* archivoTraza; // Archivo de traza binaria, o NULL para imprimir texto
+  int simulacion;         // 1 = simulación de eventos discretos con reloj virtual, 0 = hilos
+  int politica;           // POLITICA_* para elegir estación (POLITICA_PRIMERA = original)
+  int medirEstaciones;    // 1 = se pidió --politica: medir e imprimir el resumen por estación
+  int pestilloFinal;      // 1 = los hilos terminan enseguida y main espera en un pestillo (sin barrera)
+  int medirFases;         // 1 = pestillos por tarea para saber cuándo terminó cada fase
+  int medirLatencias;     // 1 = histograma de la duración de cada fase de cada auto
+  const char* tablero;    // Nombre del segmento de memoria compartida (--tablero), o NULL
+  int afinidad;           // 1 = hilos fijados a núcleos y estaciones ubicadas por nodo NUMA
+  int prioridades;        // 1 = filas por clase de auto con envejecimiento y percentiles por clase
+  int combinar;           // 1 = entradas y salidas atendidas por lotes con una sola toma del candado
+  const char* estrategia; // Nombre de la estrategia del motor, o NULL para la de siempre
+  int entradaOrdenada;    // 1 = el motor hace entrar a los autos en orden de número
+  int linea;              // 1 = el motor corre los autos por la línea de montaje (una etapa por tarea)
+  int tecnicos;           // Técnicos por estación en el motor (0 = el auto hace sus tareas solo)
+  const char* cargas;     // Factores de la tasa de llegadas separados por comas, o NULL (solo x1)
+  int fibras;             // 1 = el motor corre cada auto en una fibra en lugar de un hilo
+  int soloResumen;        // 1 = sin mensajes por auto, solo los resúmenes del final
+} Opciones;
+
+// Una marca por opción, para decirle a leerOpciones cuáles tiene el programa
+enum {
+  OPCION_POOL        = 1 << 0,
+  OPCION_LOCKFREE    = 1 << 1,
+  OPCION_LOG_ASYNC   = 1 << 2,
+  OPCION_TRAZA       = 1 << 3,
+  OPCION_SIMULACION  = 1 << 4,
+  OPCION_POLITICA    = 1 << 5,
+  OPCION_PESTILLO    = 1 << 6,
+  OPCION_FASES       = 1 << 7,
+  OPCION_LATENCIAS   = 1 << 8,
+  OPCION_TABLERO     = 1 << 9,
+  OPCION_AFINIDAD    = 1 << 10,
+  OPCION_PRIORIDADES = 1 << 11,
+  OPCION_COMBINAR    = 1 << 12,
+  OPCION_ESTRATEGIA  = 1 << 13,
+  OPCION_ENTRADA     = 1 << 14,
+  OPCION_LINEA       = 1 << 15,
+  OPCION_TECNICOS    = 1 << 16,
+  OPCION_CARGA       = 1 << 17,
+  OPCION_FIBRAS      = 1 << 18,
+  OPCION_RESUMEN     = 1 << 19,
+};
+// Las que tienen todos los programas
+#define OPCIONES_COMUNES (OPCION_LOG_ASYNC | OPCION_TRAZA | OPCION_POLITICA | OPCION_LATENCIAS | \
+                          OPCION_TABLERO | OPCION_AFINIDAD | OPCION_PRIORIDADES | OPCION_RESUMEN)
+
+/* ---------------------------------------------------------
+Lee las opciones que vienen después del archivo de configuración.
+"aceptadas" son las OPCION_* del programa. Devuelve 0 si todo está
+bien o -1 si hay una opción desconocida o que el programa no tiene.
+------------------------------------------------------------*/
+static int leerOpciones(int argc, char const* argv[], Opciones* opciones, int aceptadas) {
+  static const struct {
+    const char* nombre;
+    int opcion;
+  } nombres[] = {
+    {"--pool", OPCION_POOL},           {"--lockfree", OPCION_LOCKFREE},
+    {"--log-async", OPCION_LOG_ASYNC}, {"--traza", OPCION_TRAZA},
+    {"--simulacion", OPCION_SIMULACION}, {"--politica", OPCION_POLITICA},
+    {"--pestillo", OPCION_PESTILLO},   {"--fases", OPCION_FASES},
+    {"--latencias", OPCION_LATENCIAS}, {"--tablero", OPCION_TABLERO},
+    {"--afinidad", OPCION_AFINIDAD},   {"--prioridades", OPCION_PRIORIDADES},
+    {"--combinar", OPCION_COMBINAR},   {"--estrategia", OPCION_ESTRATEGIA},
+    {"--entrada", OPCION_ENTRADA},     {"--linea", OPCION_LINEA},
+    {"--tecnicos", OPCION_TECNICOS},   {"--carga", OPCION_CARGA},
+    {"--fibras", OPCION_FIBRAS},       {"--resumen", OPCION_RESUMEN},
+  };
+  memset(opciones, 0, sizeof(Opciones));
+  for (int i = 2; i < argc; i++) {
+    for (size_t j = 0; j < sizeof(nombres) / sizeof(nombres[0]); j++) {
+      if (strcmp(argv[i], nombres[j].nombre) == 0 && !(aceptadas & nombres[j].opcion)) {
+        fprintf(stderr, "La opción %s no está disponible en este programa\n", argv[i]);
+        return -1;
+      }
+    }
+    if (strcmp(argv[i], "--pool") == 0) {
+      opciones->modoPool = 1;
+    } else if (strcmp(argv[i], "--lockfree") == 0) {
+      opciones->estacionesLockFree = 1;
+    } else if (strcmp(argv[i], "--log-async") == 0) {
+      opciones->registroAsincrono = 1;
+    } else if (strcmp(argv[i], "--traza") == 0 && i + 1 < argc) {
+      opciones->archivoTraza = argv[++i];
+    } else if (strcmp(argv[i], "--simulacion") == 0) {
+      opciones->simulacion = 1;
+    } else if (strcmp(argv[i], "--pestillo") == 0) {
+      opciones->pestilloFinal = 1;
+    } else if (strcmp(argv[i], "--fases") == 0) {
+      opciones->medirFases = 1;
+    } else if (strcmp(argv[i], "--latencias") == 0) {
+      opciones->medirLatencias = 1;
+    } else if (strcmp(argv[i], "--tablero") == 0 && i + 1 < argc) {
+      opciones->tablero = argv[++i];
+    } else if (strcmp(argv[i], "--afinidad") == 0) {
+      opciones->afinidad = 1;
+    } else if (strcmp(argv[i], "--prioridades") == 0) {
+      opciones->prioridades = 1;
+    } else if (strcmp(argv[i], "--combinar") == 0) {
+      opciones->combinar = 1;
+    } else if (strcmp(argv[i], "--estrategia") == 0 && i + 1 < argc) {
+      opciones->estrategia = argv[++i];
+    } else if (strcmp(argv[i], "--tecnicos") == 0 && i + 1 < argc) {
+      opciones->tecnicos = atoi(argv[++i]);
+      if (opciones->tecnicos < 1) {
+        fprintf(stderr, "--tecnicos necesita al menos 1 técnico por estación\n");
+        return -1;
+      }
+    } else if (strcmp(argv[i], "--carga") == 0 && i + 1 < argc) {
+      opciones->cargas = argv[++i];
+    } else if (strcmp(argv[i], "--linea") == 0) {
+      opciones->linea = 1;
+    } else if (strcmp(argv[i], "--fibras") == 0) {
+      opciones->fibras = 1;
+    } else if (strcmp(argv[i], "--resumen") == 0) {
+      opciones->soloResumen = 1;
+    } else if (strcmp(argv[i], "--entrada") == 0 && i + 1 < argc) {
+      i++;
+      if (strcmp(argv[i], "ordenada") == 0) {
+        opciones->entradaOrdenada = 1;
+      } else if (strcmp(argv[i], "desordenada") != 0) {
+        fprintf(stderr, "Entrada desconocida: %s (ordenada o desordenada)\n", argv[i]);
+        return -1;
+      }
+    } else if (strcmp(argv[i], "--politica") == 0 && i + 1 < argc) {
+      opciones->politica = politicaPorNombre(argv[++i]);
+      opciones->medirEstaciones = 1;
+      if (opciones->politica < 0) {
+        fprintf(stderr, "Política desconocida: %s (primera, turno, jsq o dos)\n", argv[i]);
+        return -1;
+      }
+    } else {
+      fprintf(stderr, "Opción desconocida: %s\n", argv[i]);
+      return -1;
+    }
+  }
+  if (opciones->soloResumen && opciones->archivoTraza) {
+    fprintf(stderr, "--resumen no se usa con --traza (no quedaría ningún evento para guardar)\n");
+    return -1;
+  }
+  return 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+// PESTILLO DE CUENTA REGRESIVA (COMPLETION LATCH)
+//
+// Un contador atómico que arranca en N y que cada hilo baja una vez al terminar lo
+// suyo. Bajarlo no bloquea: el hilo sigue (o termina y libera su pila) enseguida.
+// Solo quien necesita saber que llegó a 0 espera (girando un poco y después en un
+// futex). Es más barato que una barrera, donde los N hilos quedan vivos y
+// bloqueados hasta que llega el último.
+//
+// Además guarda la hora en que llegó a 0, así se puede usar como "fase": por
+// ejemplo, un pestillo por tarea dice cuándo todos los autos terminaron esa tarea
+// sin frenar a ninguno.
+
+#ifndef PESTILLO_H
+#define PESTILLO_H
+
+#include <limits.h>           // Para INT_MAX
+#include <stdatomic.h>        // Para atomic_int
+#include <stdint.h>           // Para uint64_t
+#include "esperaAdaptativa.h" // Para girar un poco antes de dormir
+#include "futex.h"            // Para futexEsperar, futexDespertar
+#include "registro.h"         // Para relojNs
+
+typedef struct {
+  atomic_int faltan;    // Cuántos hilos todavía no lo bajaron
+  atomic_int abierto;   // 1 cuando llegó a 0 (y ya se anotó la hora); es la palabra del futex
+  atomic_int esperando; // Hilos bloqueados en el futex (para no despertar en vano)
+  atomic_int giros;     // Vueltas que conviene girar antes de dormir
+  uint64_t abiertoNs;   // relojNs() cuando llegó a 0 (válido cuando abierto == 1)
+} Pestillo;
+
+static void pestilloIniciar(Pestillo* p, int n) {
+  atomic_init(&p->faltan, n);
+  atomic_init(&p->abierto, n > 0 ? 0 : 1);
+  atomic_init(&p->esperando, 0);
+  atomic_init(&p->giros, GIROS_INICIALES);
+  p->abiertoNs = n > 0 ? 0 : relojNs();
+}
+
+/* ---------------------------------------------------------
+Baja el pestillo en 1 sin bloquearse. Devuelve 1 si era el
+último (y despierta a los que esperan) o 0 si faltan otros.
+Después de bajarlo el hilo no debe tocar nada que main libere
+al abrirse el pestillo.
+------------------------------------------------------------*/
+static int pestilloBajar(Pestillo* p) {
+  if (atomic_fetch_sub(&p->faltan, 1) != 1) {
+    return 0;
+  }
+  p->abiertoNs = relojNs();
+  atomic_store(&p->abierto, 1); // Publica abiertoNs junto con la apertura
+  if (atomic_load(&p->esperando) > 0) {
+    futexDespertar(&p->abierto, INT_MAX);
+  }
+  return 1;
+}
+
+// Espera (girando un poco y después en el futex) hasta que el pestillo llegue a 0
+static void pestilloEsperar(Pestillo* p) {
+  if (atomic_load(&p->abierto) || esperaAdaptativaGirar(&p->abierto, 0, &p->giros)) {
+    return;
+  }
+  atomic_fetch_add(&p->esperando, 1);
+  while (!atomic_load(&p->abierto)) {
+    futexEsperar(&p->abierto, 0); // Vuelve enseguida si ya se abrió
+  }
+  atomic_fetch_sub(&p->esperando, 1);
+}
+
+// Hora (relojNs) en que se abrió, o 0 si todavía faltan hilos
+static inline uint64_t pestilloAbiertoNs(Pestillo* p) {
+  return atomic_load(&p->abierto) ? p->abiertoNs : 0;
+}
+
+#endif
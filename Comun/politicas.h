@@ -0,0 +1,300 @@
+// POLÍTICAS PARA ELEGIR ESTACIÓN (--politica) Y MÉTRICAS POR ESTACIÓN
+//
+// Todas las variantes buscaban plaza recorriendo las estaciones desde la 1, así que
+// las primeras se llenan antes y la contención se concentra ahí. Con --politica se
+// elige cómo buscar:
+//
+//   primera  La primera estación con plaza libre (lo de siempre).
+//   turno    Round-robin: cada búsqueda arranca en la estación siguiente a la anterior.
+//   jsq      La estación con más plazas libres (join-shortest-queue: la menos cargada).
+//   dos      Power-of-two-choices: se sortean dos estaciones y se elige la de más
+//            plazas libres; si las dos están llenas se recorren las demás.
+//
+// Cada programa dice cuántas plazas libres tiene la estación i y cómo ocupar una
+// (PlazasLibresFn / OcuparPlazaFn). Con --politica además se mide, por estación,
+// cuántos autos atendió, cuánto tiempo estuvieron ocupadas sus plazas y cuánto
+// esperó cada auto desde que empezó a pedir plaza hasta que entró; al final se
+// imprime la utilización, la dispersión de las esperas y sus percentiles (p50, p90,
+// p99, p99.9) para comparar políticas y mecanismos de admisión.
+
+#ifndef POLITICAS_H
+#define POLITICAS_H
+
+#include <math.h>      // Para sqrt
+#include <pthread.h>   // Para el candado de las métricas de cada estación
+#include <stdatomic.h> // Para el turno compartido del round-robin
+#include <stdint.h>    // Para uint64_t
+#include <stdio.h>     // Para printf
+#include <stdlib.h>    // Para calloc, free
+#include <string.h>    // Para strcmp
+#include "afinidad.h"  // Para preferir las estaciones del nodo NUMA del hilo (--afinidad)
+#include "latencias.h" // Para el histograma de las esperas y sus percentiles
+#include "lineaCache.h" // Para PlazasEstacion
+#include "registro.h"  // Para relojNs
+
+enum { POLITICA_PRIMERA, POLITICA_TURNO, POLITICA_MAS_LIBRE, POLITICA_DOS_AL_AZAR, N_POLITICAS };
+
+// Nombres de las políticas en la línea de comandos, en el orden de POLITICA_*
+static const char* const nombresPolitica[N_POLITICAS] = {"primera", "turno", "jsq", "dos"};
+
+// Plazas libres de la estación i (0..n-1) y cómo ocupar una (1 si la ocupó)
+typedef int (*PlazasLibresFn)(void* estaciones, int i);
+typedef int (*OcuparPlazaFn)(void* estaciones, int i);
+
+// Devuelve la política con ese nombre o -1 si no existe
+static inline int politicaPorNombre(const char* nombre) {
+  for (int i = 0; i < N_POLITICAS; i++) {
+    if (strcmp(nombre, nombresPolitica[i]) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Número al azar en [0, n) con xorshift; cada hilo tiene su propio estado
+static int politicaAzar(int n) {
+  static __thread uint64_t estado = 0;
+  if (estado == 0) {
+    estado = (uint64_t)(uintptr_t)&estado * 0x9E3779B97F4A7C15ull | 1;
+  }
+  estado ^= estado << 13;
+  estado ^= estado >> 7;
+  estado ^= estado << 17;
+  return (int)(estado % (uint64_t)n);
+}
+
+// Primera estación con plaza libre a partir de "desde" (dando la vuelta), o -1
+static int politicaRecorrer(int nEstaciones, int desde, PlazasLibresFn libres, void* estaciones) {
+  for (int k = 0; k < nEstaciones; k++) {
+    int i = desde + k < nEstaciones ? desde + k : desde + k - nEstaciones;
+    if (libres(estaciones, i) > 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/* ---------------------------------------------------------
+Elige, según la política, una estación (0..n-1) que tenía
+plaza libre al mirarla, o -1 si todas estaban llenas.
+------------------------------------------------------------*/
+static int politicaElegir(int politica, int nEstaciones, PlazasLibresFn libres, void* estaciones) {
+  static atomic_uint siguienteTurno;
+  switch (politica) {
+  case POLITICA_TURNO: {
+    unsigned turno = atomic_fetch_add_explicit(&siguienteTurno, 1, memory_order_relaxed);
+    return politicaRecorrer(nEstaciones, (int)(turno % (unsigned)nEstaciones), libres, estaciones);
+  }
+  case POLITICA_MAS_LIBRE: {
+    int mejor = -1, masLibres = 0;
+    for (int i = 0; i < nEstaciones; i++) {
+      int l = libres(estaciones, i);
+      if (l > masLibres) {
+        masLibres = l;
+        mejor = i;
+      }
+    }
+    return mejor;
+  }
+  case POLITICA_DOS_AL_AZAR: {
+    int a = politicaAzar(nEstaciones), b = politicaAzar(nEstaciones);
+    int libresA = libres(estaciones, a), libresB = libres(estaciones, b);
+    if (libresA > 0 || libresB > 0) {
+      return libresA >= libresB ? a : b;
+    }
+    return politicaRecorrer(nEstaciones, a, libres, estaciones);
+  }
+  default:
+    return politicaRecorrer(nEstaciones, 0, libres, estaciones);
+  }
+}
+
+// Con --afinidad: la función de plazas libres de verdad, para filtrarla por nodo
+static __thread PlazasLibresFn libresSinFiltrar;
+
+// Plazas libres de la estación i si está en el nodo del hilo; las de otros nodos cuentan como llenas
+static int politicaLibresEnMiNodo(void* estaciones, int i) {
+  return afinidadEstacionCercana(i) ? libresSinFiltrar(estaciones, i) : 0;
+}
+
+/* ---------------------------------------------------------
+Busca estación con la política y ocupa una plaza. Si otro
+auto se adelantó y la plaza ya no está, vuelve a elegir.
+Con --afinidad prueba primero las estaciones de su nodo.
+Devuelve la estación asignada (1..n) o -1 si no hay lugar.
+------------------------------------------------------------*/
+static int politicaTomar(int politica, int nEstaciones, PlazasLibresFn libres, OcuparPlazaFn ocupar,
+                         void* estaciones) {
+  int i;
+  if (afinidadPreferirNodo()) {
+    libresSinFiltrar = libres;
+    while ((i = politicaElegir(politica, nEstaciones, politicaLibresEnMiNodo, estaciones)) >= 0) {
+      if (ocupar(estaciones, i)) {
+        return i + 1;
+      }
+    }
+  }
+  while ((i = politicaElegir(politica, nEstaciones, libres, estaciones)) >= 0) {
+    if (ocupar(estaciones, i)) {
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+// Plazas libres en un array de PlazasEstacion (las variantes que cuentan las plazas bajo un mutex)
+static inline int politicaLibresEnPlazas(void* estaciones, int i) {
+  return ((PlazasEstacion*)estaciones)[i].plazasLibres;
+}
+
+// Ocupa una plaza de un array de PlazasEstacion; se llama con el mutex tomado, así que siempre puede
+static inline int politicaOcuparEnPlazas(void* estaciones, int i) {
+  ((PlazasEstacion*)estaciones)[i].plazasLibres--;
+  return 1;
+}
+
+// Métricas de una estación (cada una con su candado para no agregar un cuello de botella).
+// Alineadas a su propia línea: anotar en una estación no invalida la de las vecinas.
+typedef struct {
+  _Alignas(LINEA_CACHE) pthread_mutex_t candado;
+  long long autos;
+  double ocupadoS;                        // Suma del tiempo que estuvieron ocupadas sus plazas
+  double esperaS, esperaCuadradoS;        // Suma de las esperas y de sus cuadrados
+  double esperaMaximaS;
+} MetricasEstacion;
+
+typedef struct {
+  int activas;                            // 0 = no se mide nada (sin --politica)
+  int nEstaciones;
+  MetricasEstacion* estaciones;
+  uint64_t inicioNs;
+  // Esperas de todos los autos para sacar percentiles, en las cubetas de latencias.h:
+  // contadores atómicos compartidos, no hace falta guardar cada espera
+  atomic_llong histogramaEspera[CUBETAS_LATENCIA];
+  atomic_ullong esperaMaximaNs;
+} MetricasEstaciones;
+
+static MetricasEstaciones metricas;
+
+// Empieza a medir (llamar antes de crear los hilos). Devuelve -1 si no hay memoria.
+static inline int metricasIniciar(int nEstaciones) {
+  metricas.nEstaciones = nEstaciones;
+  metricas.estaciones = afinidadReservar(nEstaciones, sizeof(MetricasEstacion));
+  if (!metricas.estaciones) {
+    return -1;
+  }
+  for (int i = 0; i < nEstaciones; i++) {
+    pthread_mutex_init(&metricas.estaciones[i].candado, NULL);
+  }
+  // El motor mide varias corridas seguidas en el mismo proceso (--estrategia todas)
+  for (int c = 0; c < CUBETAS_LATENCIA; c++) {
+    atomic_store(&metricas.histogramaEspera[c], 0);
+  }
+  atomic_store(&metricas.esperaMaximaNs, 0);
+  metricas.inicioNs = relojNs();
+  metricas.activas = 1;
+  return 0;
+}
+
+// El auto entró a la estación (1..n) después de esperar "esperaNs"
+static inline void metricasIngreso(int estacion, uint64_t esperaNs) {
+  if (!metricas.activas) {
+    return;
+  }
+  latenciasAnotarEn(metricas.histogramaEspera, &metricas.esperaMaximaNs, esperaNs);
+  MetricasEstacion* m = &metricas.estaciones[estacion - 1];
+  double espera = esperaNs / 1e9;
+  pthread_mutex_lock(&m->candado);
+  m->autos++;
+  m->esperaS += espera;
+  m->esperaCuadradoS += espera * espera;
+  if (espera > m->esperaMaximaS) {
+    m->esperaMaximaS = espera;
+  }
+  pthread_mutex_unlock(&m->candado);
+}
+
+// El auto dejó la estación (1..n) después de ocupar su plaza "ocupadoNs"
+static inline void metricasSalida(int estacion, uint64_t ocupadoNs) {
+  if (!metricas.activas) {
+    return;
+  }
+  MetricasEstacion* m = &metricas.estaciones[estacion - 1];
+  pthread_mutex_lock(&m->candado);
+  m->ocupadoS += ocupadoNs / 1e9;
+  pthread_mutex_unlock(&m->candado);
+}
+
+// Estaciones hasta las que se imprime una línea por estación (después, solo el resumen)
+#define MAX_ESTACIONES_DETALLE 100
+
+/* ---------------------------------------------------------
+Imprime, para la política usada, la utilización y la espera
+de cada estación y la dispersión entre estaciones y autos.
+"capacidades" es la cantidad de plazas de cada estación.
+------------------------------------------------------------*/
+static inline void metricasImprimir(int politica, const int* capacidades) {
+  if (!metricas.activas) {
+    return;
+  }
+  double duracion = (relojNs() - metricas.inicioNs) / 1e9;
+  long long autos = 0;
+  double espera = 0, esperaCuadrado = 0, esperaMaxima = 0;
+  double utilizacion = 0, utilizacionCuadrado = 0, utilizacionMinima = 100, utilizacionMaxima = 0;
+  int conPlazas = 0;
+  printf("Política %s: %.3f s\n", nombresPolitica[politica], duracion);
+  for (int i = 0; i < metricas.nEstaciones; i++) {
+    const MetricasEstacion* m = &metricas.estaciones[i];
+    autos += m->autos;
+    espera += m->esperaS;
+    esperaCuadrado += m->esperaCuadradoS;
+    if (m->esperaMaximaS > esperaMaxima) {
+      esperaMaxima = m->esperaMaximaS;
+    }
+    if (capacidades[i] == 0) {
+      continue; // Estación cerrada: no cuenta para la utilización
+    }
+    double u = duracion > 0 ? 100.0 * m->ocupadoS / (duracion * capacidades[i]) : 0;
+    conPlazas++;
+    utilizacion += u;
+    utilizacionCuadrado += u * u;
+    if (u < utilizacionMinima) {
+      utilizacionMinima = u;
+    }
+    if (u > utilizacionMaxima) {
+      utilizacionMaxima = u;
+    }
+    if (metricas.nEstaciones <= MAX_ESTACIONES_DETALLE) {
+      printf("Estación %d: %lld autos, utilización %.1f%%, espera media %.6f s (máxima %.6f s)\n", i + 1,
+             m->autos, u, m->autos ? m->esperaS / m->autos : 0, m->esperaMaximaS);
+    }
+  }
+  if (conPlazas > 0) {
+    double media = utilizacion / conPlazas;
+    printf("Utilización por estación: media %.1f%%, desvío %.1f%%, mínima %.1f%%, máxima %.1f%%\n", media,
+           sqrt(fmax(0, utilizacionCuadrado / conPlazas - media * media)), utilizacionMinima, utilizacionMaxima);
+  }
+  if (autos > 0) {
+    double media = espera / autos;
+    printf("Espera por auto: media %.6f s, desvío %.6f s, máxima %.6f s (%lld autos)\n", media,
+           sqrt(fmax(0, esperaCuadrado / autos - media * media)), esperaMaxima, autos);
+    long long cuentas[CUBETAS_LATENCIA];
+    for (int c = 0; c < CUBETAS_LATENCIA; c++) {
+      cuentas[c] = atomic_load_explicit(&metricas.histogramaEspera[c], memory_order_relaxed);
+    }
+    latenciasImprimirLinea("Percentiles de espera", cuentas, autos, atomic_load(&metricas.esperaMaximaNs));
+  }
+}
+
+static inline void metricasDestruir(void) {
+  if (!metricas.activas) {
+    return;
+  }
+  for (int i = 0; i < metricas.nEstaciones; i++) {
+    pthread_mutex_destroy(&metricas.estaciones[i].candado);
+  }
+  afinidadLiberar(metricas.estaciones, metricas.nEstaciones, sizeof(MetricasEstacion));
+  metricas.activas = 0;
+}
+
+#endif
@@ -0,0 +1,173 @@
+// CLASES DE PRIORIDAD CON ENVEJECIMIENTO (--prioridades)
+//
+// Todos los autos eran iguales: entraban por turno o por quien ganara la carrera. Con
+// --prioridades cada auto tiene la clase que le da el escenario (flota, garantía o
+// particular; ver la directiva "clase" en escenario.h) y las filas de espera (la de
+// traspaso.h y las colas por estación de la variante Colas) tienen una sub-fila FIFO
+// por clase. Quien libera una plaza se la pasa al auto con el plazo más próximo:
+//
+//   plazo = momento en que se anotó + clase * envejecimiento
+//
+// Es decir, cada "envejecimiento" segundos de espera un auto sube una clase: un
+// particular que ya esperó dos envejecimientos le gana a un auto de flota recién
+// llegado, así que nadie se queda sin entrar aunque no paren de llegar autos de flota.
+// Dentro de una clase los plazos crecen en el orden de la fila, así que alcanza con
+// comparar la cabeza de cada sub-fila (N_CLASES comparaciones, sin leer el reloj).
+//
+// Sin --prioridades todos los autos son particulares y la fila es la FIFO de siempre.
+// En las variantes sin fila (Condicion, Espera, Barrera y Fibras) el que entra sigue
+// siendo el que gana la carrera: ahí la opción solo mide cada clase.
+//
+// Al final se imprimen por clase los percentiles de la espera (hasta entrar) y del
+// tiempo total, con los histogramas de latencias.h, para comprobar que el p99 de la
+// flota queda acotado aunque el centro esté sobrecargado.
+
+#ifndef PRIORIDADES_H
+#define PRIORIDADES_H
+
+#include <stdatomic.h>  // Para los histogramas de cada clase
+#include <stdint.h>     // Para uint64_t
+#include <stdio.h>      // Para snprintf
+#include <string.h>     // Para memset
+#include "escenario.h"  // Para CLASE_* y escenarioClaseDeAuto
+#include "latencias.h"  // Para las cubetas y los percentiles de los histogramas
+#include "registro.h"   // Para relojNs
+
+enum { MEDIDA_ESPERA, MEDIDA_TOTAL, N_MEDIDAS };
+
+typedef struct {
+  int activas;               // 0 = sin --prioridades: todos particulares y nada que medir
+  const Escenario* escenario;
+  uint64_t envejecimientoNs; // Espera para subir una clase
+  atomic_llong cuentas[N_CLASES][N_MEDIDAS][CUBETAS_LATENCIA];
+  atomic_ullong maximos[N_CLASES][N_MEDIDAS];
+} Prioridades;
+
+static Prioridades prioridades;
+
+static const char* const nombresClase[N_CLASES] = {"flota", "garantía", "particular"};
+
+// Un auto anotado en una fila (va dentro de la estructura del que espera)
+typedef struct EnFila {
+  struct EnFila* siguiente; // Siguiente de su misma clase
+  uint64_t plazoNs;         // Cuándo se anotó + clase * envejecimiento
+  int clase;
+} EnFila;
+
+// Fila de espera con una sub-fila FIFO por clase (se usa siempre con el candado de su dueño)
+typedef struct {
+  EnFila* primero[N_CLASES];
+  EnFila* ultimo[N_CLASES];
+} FilaPrioridades;
+
+// Empieza a usar las clases del escenario con los histogramas en cero (llamar antes
+// de crear los hilos; el motor lo hace en cada corrida)
+static inline void prioridadesIniciar(const Escenario* escenario) {
+  memset(prioridades.cuentas, 0, sizeof(prioridades.cuentas));
+  memset(prioridades.maximos, 0, sizeof(prioridades.maximos));
+  prioridades.escenario = escenario;
+  prioridades.envejecimientoNs = (uint64_t)(escenario->envejecimiento * 1e9);
+  prioridades.activas = 1;
+}
+
+// Clase del auto; sin --prioridades todos son particulares
+static inline int prioridadesClase(int indiceAuto) {
+  return prioridades.activas ? escenarioClaseDeAuto(prioridades.escenario, indiceAuto) : CLASE_PARTICULAR;
+}
+
+static inline void filaPrioridadesIniciar(FilaPrioridades* f) {
+  for (int c = 0; c < N_CLASES; c++) {
+    f->primero[c] = f->ultimo[c] = NULL;
+  }
+}
+
+// Anota al auto "indiceAuto" al final de la sub-fila de su clase
+static inline void filaPrioridadesPoner(FilaPrioridades* f, EnFila* nodo, int indiceAuto) {
+  nodo->clase = prioridadesClase(indiceAuto);
+  nodo->plazoNs = prioridades.activas ? relojNs() + nodo->clase * prioridades.envejecimientoNs : 0;
+  nodo->siguiente = NULL;
+  if (f->ultimo[nodo->clase]) {
+    f->ultimo[nodo->clase]->siguiente = nodo;
+  } else {
+    f->primero[nodo->clase] = nodo;
+  }
+  f->ultimo[nodo->clase] = nodo;
+}
+
+static inline int filaPrioridadesVacia(const FilaPrioridades* f) {
+  for (int c = 0; c < N_CLASES; c++) {
+    if (f->primero[c]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Saca al auto con el plazo más próximo (NULL si la fila está vacía)
+static inline EnFila* filaPrioridadesSacar(FilaPrioridades* f) {
+  int elegida = -1;
+  for (int c = 0; c < N_CLASES; c++) {
+    if (f->primero[c] && (elegida < 0 || f->primero[c]->plazoNs < f->primero[elegida]->plazoNs)) {
+      elegida = c;
+    }
+  }
+  if (elegida < 0) {
+    return NULL;
+  }
+  EnFila* nodo = f->primero[elegida];
+  f->primero[elegida] = nodo->siguiente;
+  if (!f->primero[elegida]) {
+    f->ultimo[elegida] = NULL;
+  }
+  return nodo;
+}
+
+static inline void prioridadesAnotar(int indiceAuto, int medida, uint64_t ns) {
+  int clase = prioridadesClase(indiceAuto);
+  latenciasAnotarEn(prioridades.cuentas[clase][medida], &prioridades.maximos[clase][medida], ns);
+}
+
+// El auto entró después de esperar "esperaNs" (sin --prioridades no hace nada)
+static inline void prioridadesIngreso(int indiceAuto, uint64_t esperaNs) {
+  if (prioridades.activas) {
+    prioridadesAnotar(indiceAuto, MEDIDA_ESPERA, esperaNs);
+  }
+}
+
+// El auto terminó todo; llegó en "llegadaNs" (sin --prioridades no lee el reloj)
+static inline void prioridadesSalida(int indiceAuto, uint64_t llegadaNs) {
+  if (prioridades.activas) {
+    prioridadesAnotar(indiceAuto, MEDIDA_TOTAL, relojNs() - llegadaNs);
+  }
+}
+
+/* ---------------------------------------------------------
+Imprime los percentiles de espera y de tiempo total de cada
+clase (llamar después de que terminaron los hilos). Las clases
+sin autos no se imprimen.
+------------------------------------------------------------*/
+static inline void prioridadesImprimir(void) {
+  if (!prioridades.activas) {
+    return;
+  }
+  for (int clase = 0; clase < N_CLASES; clase++) {
+    for (int medida = 0; medida < N_MEDIDAS; medida++) {
+      long long cuentas[CUBETAS_LATENCIA];
+      long long n = 0;
+      for (int c = 0; c < CUBETAS_LATENCIA; c++) {
+        cuentas[c] = atomic_load_explicit(&prioridades.cuentas[clase][medida][c], memory_order_relaxed);
+        n += cuentas[c];
+      }
+      if (n == 0) {
+        continue;
+      }
+      char titulo[64];
+      snprintf(titulo, sizeof(titulo), "%s clase %s", medida == MEDIDA_ESPERA ? "Espera" : "Total",
+               nombresClase[clase]);
+      latenciasImprimirLinea(titulo, cuentas, n,
+                             atomic_load_explicit(&prioridades.maximos[clase][medida], memory_order_relaxed));
+    }
+  }
+}
+
+#endif
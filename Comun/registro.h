@@ -0,0 +1,343 @@
+// REGISTRO DE EVENTOS: SÍNCRONO (printf bajo mutex) O ASÍNCRONO (anillos por hilo)
+//
+// Cada cambio de estado de un auto se registra como un Evento pequeño. En modo
+// síncrono se imprime en el momento, con el mutex del programa tomado, igual que
+// los printf originales. En modo asíncrono (--log-async) cada hilo deja sus eventos
+// en su propio anillo (un productor, un consumidor, sin candados) y un único hilo
+// escritor los formatea y los manda a la salida estándar con write(2) por lotes.
+//
+// El texto de cada mensaje lo pone cada programa en su tabla de formatos, así que
+// la salida es la misma en los dos modos. Lo que cambia en modo asíncrono es que
+// las líneas de hilos distintos pueden quedar intercaladas en otro orden (las de
+// un mismo auto siempre salen en orden).
+//
+// Con --traza <archivo> no se formatea nada: se guarda cada Evento tal cual
+// (24 bytes) en un archivo binario. Formato del archivo (little-endian):
+//   "TSLATRZ1"                      8 bytes de firma
+//   uint32 tamaño de cada evento    (24; las trazas viejas de 16 tenían la estación en 16 bits)
+//   uint32 cantidad de formatos     y por cada uno: uint32 largo + texto UTF-8
+//   uint32 cantidad de tareas       y por cada una: uint32 largo + texto UTF-8
+//   eventos de 24 bytes hasta el final del archivo (ver struct Evento)
+// Herramientas/decodificarTraza.py lo vuelve a texto o calcula estadísticas por auto.
+
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <fcntl.h>     // Para open
+#include <pthread.h>   // Para el hilo escritor, pthread_key_t y el mutex del modo síncrono
+#include <sched.h>     // Para sched_yield
+#include <stdatomic.h> // Para los índices de los anillos
+#include <stdint.h>    // Para uint64_t, int32_t, etc.
+#include <stdio.h>     // Para snprintf, fputs
+#include <stdlib.h>    // Para calloc, free
+#include <string.h>    // Para strlen, memcpy
+#include <time.h>      // Para clock_gettime, nanosleep
+#include <unistd.h>    // Para write, close
+
+// Tipos de evento (cada programa da el texto de cada uno en su tabla de formatos)
+enum {
+  EVENTO_INGRESO,      // formato(indiceAuto, estacion)
+  EVENTO_ESPERA,       // formato(indiceAuto)
+  EVENTO_INICIO_TAREA, // formato(indiceAuto, nombreTarea, estacion)
+  EVENTO_FIN_TAREA,    // formato(indiceAuto, nombreTarea, estacion)
+  EVENTO_FIN_TODO,     // formato(indiceAuto)
+  N_TIPOS_EVENTO
+};
+
+// Un evento ocupa 24 bytes fijos (es también el registro del archivo de traza)
+typedef struct {
+  uint64_t tiempoNs;   // Reloj monótono en nanosegundos
+  int32_t indiceAuto;  // 1..nAutos
+  int32_t estacion;    // 1..nEstaciones (0 si todavía no tiene); un escenario puede tener
+                       // cientos de miles de estaciones, que no entran en 16 bits
+  uint8_t tipo;        // EVENTO_*
+  uint8_t tarea;       // Índice en tareas[] (solo para las tareas)
+  uint8_t relleno[6];  // Explícito, para que el archivo no guarde basura
+} Evento;
+
+// Eventos que caben en el anillo de cada hilo (potencia de 2)
+#define TAM_ANILLO 256
+// Tamaño del lote que junta el escritor antes de cada write(2)
+#define TAM_LOTE (64 * 1024)
+
+typedef struct AnilloEventos {
+  Evento eventos[TAM_ANILLO];
+  _Alignas(64) atomic_uint cabeza; // Próxima posición a escribir (solo la mueve el hilo dueño)
+  _Alignas(64) atomic_uint cola;   // Próxima posición a leer (solo la mueve el escritor)
+  atomic_int terminado;            // 1 cuando el hilo dueño ya salió
+  struct AnilloEventos* siguiente; // Lista de anillos que recorre el escritor
+} AnilloEventos;
+
+typedef struct {
+  int asincrono;
+  pthread_mutex_t* mutex;        // Mutex del programa para el modo síncrono
+  const char* const* formatos;   // Texto de cada tipo de evento
+  char* const* nombresTareas;    // Nombres de las tareas (tareas[] del programa)
+  int nTareas;
+  int salida;                    // Descriptor donde escribe el escritor (stdout o la traza)
+  int binario;                   // 1 = se guardan los eventos crudos (--traza)
+  int silencioso;                // 1 = los eventos no se imprimen ni se guardan (--resumen)
+  char* lote;                    // Traza en modo síncrono: eventos juntados bajo el mutex
+  size_t usado;
+  _Atomic(AnilloEventos*) anillos; // Lista de anillos registrados
+  atomic_int fin;                // 1 cuando main pide vaciar todo y terminar
+  pthread_t escritor;
+  pthread_key_t claveAnillo;     // Para marcar el anillo como terminado al salir el hilo
+} Registro;
+
+static Registro registro;
+static __thread AnilloEventos* anilloDelHilo = NULL;
+
+static inline uint64_t relojNs(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000ull + (uint64_t)t.tv_nsec;
+}
+
+// Escribe en "destino" la línea de texto del evento (con su salto de línea)
+static int registroFormatear(char* destino, size_t tam, const Evento* e) {
+  const char* formato = registro.formatos[e->tipo];
+  switch (e->tipo) {
+  case EVENTO_INGRESO:
+    return snprintf(destino, tam, formato, e->indiceAuto, e->estacion);
+  case EVENTO_ESPERA:
+  case EVENTO_FIN_TODO:
+    return snprintf(destino, tam, formato, e->indiceAuto);
+  default:
+    return snprintf(destino, tam, formato, e->indiceAuto, registro.nombresTareas[e->tarea], e->estacion);
+  }
+}
+
+// Manda todo el lote a la salida (write puede escribir menos de lo pedido)
+static void registroVolcar(char* lote, size_t* usado) {
+  size_t escrito = 0;
+  while (escrito < *usado) {
+    ssize_t n = write(registro.salida, lote + escrito, *usado - escrito);
+    if (n <= 0) {
+      break;
+    }
+    escrito += (size_t)n;
+  }
+  *usado = 0;
+}
+
+// Destructor de la clave: el hilo dueño terminó, el escritor puede liberar el anillo
+static void registroHiloTerminado(void* anillo) {
+  atomic_store(&((AnilloEventos*)anillo)->terminado, 1);
+}
+
+/* ---------------------------------------------------------
+Hilo escritor: recorre los anillos, formatea los eventos en un
+lote y lo manda con write(2). Libera los anillos de hilos que
+ya terminaron y quedaron vacíos. Sale cuando main pidió el fin
+y no queda nada por escribir.
+------------------------------------------------------------*/
+static void* registroEscritorRoutine(void* arg) {
+  (void)arg;
+  char* lote = malloc(TAM_LOTE);
+  size_t usado = 0;
+  while (1) {
+    int fin = atomic_load(&registro.fin); // Se lee antes de la pasada para no perder nada
+    int leidos = 0;
+    AnilloEventos* anterior = NULL;
+    AnilloEventos* anillo = atomic_load(&registro.anillos);
+    while (anillo) {
+      unsigned cola = atomic_load_explicit(&anillo->cola, memory_order_relaxed);
+      unsigned cabeza = atomic_load_explicit(&anillo->cabeza, memory_order_acquire);
+      for (; cola != cabeza; cola++, leidos++) {
+        if (usado + 512 > TAM_LOTE) {
+          registroVolcar(lote, &usado);
+        }
+        if (registro.binario) {
+          memcpy(lote + usado, &anillo->eventos[cola % TAM_ANILLO], sizeof(Evento));
+          usado += sizeof(Evento);
+        } else {
+          usado += registroFormatear(lote + usado, TAM_LOTE - usado, &anillo->eventos[cola % TAM_ANILLO]);
+        }
+      }
+      atomic_store_explicit(&anillo->cola, cola, memory_order_release);
+
+      AnilloEventos* siguiente = anillo->siguiente;
+      if (atomic_load(&anillo->terminado) && cola == atomic_load(&anillo->cabeza)) {
+        // Sacar el anillo de la lista: los hilos solo agregan por la cabeza de la lista
+        AnilloEventos* esperado = anillo;
+        if (anterior) {
+          anterior->siguiente = siguiente;
+          free(anillo);
+        } else if (atomic_compare_exchange_strong(&registro.anillos, &esperado, siguiente)) {
+          free(anillo);
+        } else {
+          anterior = anillo; // Alguien agregó uno nuevo adelante; se libera en otra pasada
+        }
+      } else {
+        anterior = anillo;
+      }
+      anillo = siguiente;
+    }
+
+    if (leidos == 0) {
+      registroVolcar(lote, &usado);
+      if (fin) {
+        break;
+      }
+      // No había nada: descanso un poco antes de la próxima pasada
+      struct timespec pausa = {0, 200000};
+      nanosleep(&pausa, NULL);
+    }
+  }
+  free(lote);
+  return NULL;
+}
+
+// Escribe un texto en la cabecera de la traza: largo (uint32) y los bytes sin el '\0'
+static void registroCabeceraTexto(char* cabecera, size_t* usado, const char* texto) {
+  uint32_t largo = (uint32_t)strlen(texto);
+  memcpy(cabecera + *usado, &largo, sizeof(largo));
+  memcpy(cabecera + *usado + sizeof(largo), texto, largo);
+  *usado += sizeof(largo) + largo;
+}
+
+// Crea el archivo de traza y escribe la cabecera con los formatos y los nombres de tareas
+static int registroAbrirTraza(const char* ruta) {
+  registro.salida = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (registro.salida < 0) {
+    return -1;
+  }
+  char cabecera[TAM_LOTE];
+  size_t usado = 0;
+  uint32_t numeros[] = {sizeof(Evento), N_TIPOS_EVENTO, (uint32_t)registro.nTareas};
+  memcpy(cabecera, "TSLATRZ1", 8);
+  usado = 8;
+  memcpy(cabecera + usado, &numeros[0], 2 * sizeof(uint32_t));
+  usado += 2 * sizeof(uint32_t);
+  for (int i = 0; i < N_TIPOS_EVENTO; i++) {
+    registroCabeceraTexto(cabecera, &usado, registro.formatos[i]);
+  }
+  memcpy(cabecera + usado, &numeros[2], sizeof(uint32_t));
+  usado += sizeof(uint32_t);
+  for (int i = 0; i < registro.nTareas; i++) {
+    registroCabeceraTexto(cabecera, &usado, registro.nombresTareas[i]);
+  }
+  registroVolcar(cabecera, &usado);
+  return 0;
+}
+
+/* ---------------------------------------------------------
+Prepara el registro. "formatos" tiene un texto por tipo de
+evento, "nombresTareas" es el tareas[] del programa (con nTareas
+nombres) y "mutex" es el que protege la consola en modo síncrono.
+Si rutaTraza no es NULL los eventos se guardan en binario en ese
+archivo y no se imprimen: con el escritor asíncrono, o en modo
+síncrono juntándolos en un lote bajo el mutex. Con "silencioso"
+los eventos se descartan sin formatearlos (ni escritor ni traza).
+Devuelve -1 si no se pudo abrir la traza o crear el escritor.
+------------------------------------------------------------*/
+static int registroIniciar(const char* const* formatos, char* const* nombresTareas, int nTareas,
+                           pthread_mutex_t* mutex, int asincrono, const char* rutaTraza, int silencioso) {
+  registro.formatos = formatos;
+  registro.nombresTareas = nombresTareas;
+  registro.nTareas = nTareas;
+  registro.mutex = mutex;
+  registro.silencioso = silencioso;
+  if (silencioso) {
+    return 0;
+  }
+  registro.asincrono = asincrono;
+  registro.binario = rutaTraza != NULL;
+  registro.salida = STDOUT_FILENO;
+  if (registro.binario && registroAbrirTraza(rutaTraza) != 0) {
+    return -1;
+  }
+  if (!registro.asincrono) {
+    if (registro.binario && !(registro.lote = malloc(TAM_LOTE))) {
+      return -1;
+    }
+    return 0;
+  }
+  pthread_key_create(&registro.claveAnillo, registroHiloTerminado);
+  return pthread_create(&registro.escritor, NULL, registroEscritorRoutine, NULL) == 0 ? 0 : -1;
+}
+
+// Espera a que el escritor vacíe todos los anillos (llamar cuando ya no quedan hilos de autos)
+static void registroTerminar(void) {
+  if (registro.asincrono) {
+    atomic_store(&registro.fin, 1);
+    pthread_join(registro.escritor, NULL);
+  }
+  if (registro.binario) {
+    if (registro.lote) {
+      registroVolcar(registro.lote, &registro.usado);
+      free(registro.lote);
+    }
+    close(registro.salida);
+  }
+}
+
+// Crea el anillo del hilo actual y lo agrega a la lista del escritor
+static AnilloEventos* registroAnilloNuevo(void) {
+  AnilloEventos* anillo = calloc(1, sizeof(AnilloEventos));
+  if (!anillo) {
+    return NULL;
+  }
+  pthread_setspecific(registro.claveAnillo, anillo);
+  AnilloEventos* cabeza = atomic_load(&registro.anillos);
+  do {
+    anillo->siguiente = cabeza;
+  } while (!atomic_compare_exchange_weak(&registro.anillos, &cabeza, anillo));
+  return anillo;
+}
+
+/* ---------------------------------------------------------
+Registra un evento del auto. En modo síncrono lo imprime ya
+(tomando el mutex) o lo agrega al lote de la traza; en modo asíncrono lo deja en el anillo del
+hilo, sin candados. Si el anillo está lleno espera a que el
+escritor haga lugar. "tiempoNs" es la hora del evento (el reloj
+monótono, o el reloj virtual de la simulación).
+------------------------------------------------------------*/
+static void registrarEventoEn(uint64_t tiempoNs, int tipo, int indiceAuto, int estacion, int tarea) {
+  if (registro.silencioso) {
+    return;
+  }
+  Evento e = {tiempoNs, indiceAuto, estacion, (uint8_t)tipo, (uint8_t)tarea, {0}};
+  if (!registro.asincrono && registro.binario) {
+    pthread_mutex_lock(registro.mutex);
+    if (registro.usado + sizeof(Evento) > TAM_LOTE) {
+      registroVolcar(registro.lote, &registro.usado);
+    }
+    memcpy(registro.lote + registro.usado, &e, sizeof(Evento));
+    registro.usado += sizeof(Evento);
+    pthread_mutex_unlock(registro.mutex);
+    return;
+  }
+  if (!registro.asincrono) {
+    char linea[512];
+    registroFormatear(linea, sizeof(linea), &e);
+    pthread_mutex_lock(registro.mutex);
+    fputs(linea, stdout);
+    pthread_mutex_unlock(registro.mutex);
+    return;
+  }
+
+  AnilloEventos* anillo = anilloDelHilo;
+  if (!anillo) {
+    anillo = anilloDelHilo = registroAnilloNuevo();
+    if (!anillo) {
+      return; // Sin memoria: se pierde el evento pero el auto sigue
+    }
+  }
+  unsigned cabeza = atomic_load_explicit(&anillo->cabeza, memory_order_relaxed);
+  while (cabeza - atomic_load_explicit(&anillo->cola, memory_order_acquire) >= TAM_ANILLO) {
+    sched_yield(); // Anillo lleno
+  }
+  anillo->eventos[cabeza % TAM_ANILLO] = e;
+  atomic_store_explicit(&anillo->cabeza, cabeza + 1, memory_order_release);
+}
+
+// Registra un evento con la hora actual del reloj monótono
+static void registrarEvento(int tipo, int indiceAuto, int estacion, int tarea) {
+  if (!registro.silencioso) {
+    registrarEventoEn(relojNs(), tipo, indiceAuto, estacion, tarea);
+  }
+}
+
+#endif
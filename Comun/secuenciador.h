@@ -0,0 +1,74 @@
+// SECUENCIADOR DE ADMISIÓN ORDENADA (TURNO POR TICKET)
+//
+// Sustituye al par turnoMutex/turnoCond con pthread_cond_broadcast: cada auto
+// espera en su propia casilla (una palabra futex) y quien termina su turno
+// despierta solo a la casilla del siguiente. Así cada admisión cuesta un único
+// despertar, en vez de despertar a los N autos que estén esperando. Antes de
+// dormir, el auto gira un poco por si el turno le llega enseguida (ver
+// esperaAdaptativa.h).
+
+#ifndef SECUENCIADOR_H
+#define SECUENCIADOR_H
+
+#include <stdlib.h> // Para calloc, free
+#include "futex.h"  // Para futexEsperar, futexDespertar
+#include "esperaAdaptativa.h" // Para girar un poco antes de dormir
+
+// Estados de cada casilla
+#define TURNO_NO     0 // Todavía no le toca
+#define TURNO_SI     1 // Ya le toca (o ya pasó)
+#define TURNO_DUERME 2 // No le toca y el auto está bloqueado en el futex
+
+typedef struct {
+  atomic_int* casillas; // casillas[i] = estado del turno del auto i+1
+  int nAutos;
+  atomic_int giros;     // Vueltas que conviene girar antes de dormir
+} Secuenciador;
+
+/* ---------------------------------------------------------
+Reserva una casilla por auto (4 bytes cada una) y le da el
+turno al auto 1. Devuelve -1 si no hay memoria.
+------------------------------------------------------------*/
+static int secuenciadorIniciar(Secuenciador* s, int nAutos) {
+  s->nAutos = nAutos;
+  atomic_init(&s->giros, GIROS_INICIALES);
+  s->casillas = calloc(nAutos > 0 ? nAutos : 1, sizeof(atomic_int));
+  if (!s->casillas) {
+    return -1;
+  }
+  atomic_store(&s->casillas[0], TURNO_SI);
+  return 0;
+}
+
+static void secuenciadorDestruir(Secuenciador* s) {
+  free(s->casillas);
+}
+
+// Bloquea al auto "indiceAuto" (1..nAutos) hasta que sea su turno
+static void secuenciadorEsperar(Secuenciador* s, int indiceAuto) {
+  atomic_int* casilla = &s->casillas[indiceAuto - 1];
+  if (atomic_load(casilla) == TURNO_SI || esperaAdaptativaGirar(casilla, TURNO_NO, &s->giros)) {
+    return;
+  }
+  int estado = TURNO_NO;
+  // Marca la casilla como "dormido" para que quien avance sepa que debe despertarlo
+  if (!atomic_compare_exchange_strong(casilla, &estado, TURNO_DUERME) && estado == TURNO_SI) {
+    return;
+  }
+  while (atomic_load(casilla) != TURNO_SI) {
+    futexEsperar(casilla, TURNO_DUERME);
+  }
+}
+
+// El auto "indiceAuto" ya pasó: le da el turno al siguiente y solo lo despierta a él
+static void secuenciadorAvanzar(Secuenciador* s, int indiceAuto) {
+  if (indiceAuto >= s->nAutos) {
+    return; // Era el último auto
+  }
+  atomic_int* casilla = &s->casillas[indiceAuto];
+  if (atomic_exchange(casilla, TURNO_SI) == TURNO_DUERME) {
+    futexDespertar(casilla, 1);
+  }
+}
+
+#endif
@@ -0,0 +1,243 @@
+// SIMULACIÓN DE EVENTOS DISCRETOS CON RELOJ VIRTUAL (--simulacion)
+//
+// Corre el mismo modelo que los programas con hilos (las estaciones y tareas del
+// escenario, ver Comun/escenario.h) pero sin hilos ni sleeps: una agenda (heap
+// mínimo ordenado por tiempo) guarda el próximo fin de tarea de cada auto que está
+// en una estación y el reloj salta de evento en evento.
+//
+// Como en los programas, todos los autos llegan juntos en t = 0. Los que no
+// consiguen plaza esperan en fila (en orden de número) y entran apenas se libera
+// una plaza, sin el retardo del sondeo de la espera activa y registrando una sola
+// vez que esperan. Los eventos salen por registrarEventoEn con la hora virtual, así
+// que el texto y la traza (--traza) son los mismos que en la versión con hilos, y
+// con --resumen no sale ninguno (solo el resumen del final).
+// La memoria no depende de nAutos: solo hay un evento pendiente por plaza ocupada.
+
+#ifndef SIMULACION_H
+#define SIMULACION_H
+
+#include <stdint.h>  // Para uint64_t
+#include <stdio.h>   // Para printf
+#include <stdlib.h>  // Para malloc, calloc, free
+#include "registro.h" // Para registrarEventoEn y los EVENTO_*
+#include "escenario.h" // Para las capacidades, las tareas de cada auto y sus duraciones
+#include "politicas.h" // Para MAX_ESTACIONES_DETALLE
+
+// Tarea de un auto que entra y no tiene ninguna que hacer (según su perfil)
+#define SIN_TAREA 255
+
+// Fin de una tarea de un auto, a la hora "tiempoNs" del reloj virtual
+typedef struct {
+  uint64_t tiempoNs;
+  uint64_t orden;      // Desempate: a igual tiempo sale primero el que se agendó antes
+  int32_t indiceAuto;
+  int32_t estacion;    // 1..nEstaciones
+  uint8_t tarea;       // Índice de la tarea que termina (o SIN_TAREA)
+  uint64_t ingresoNs;  // Hora en que el auto entró a la estación
+} FinDeTarea;
+
+// Resultados por estación
+typedef struct {
+  int plazasLibres, capacidad;
+  long long autosAtendidos;
+  uint64_t ocupadoNs;  // Suma del tiempo que estuvieron ocupadas sus plazas
+} EstacionSimulada;
+
+typedef struct {
+  FinDeTarea* agenda;  // Heap mínimo por (tiempoNs, orden)
+  int enAgenda;
+  uint64_t siguienteOrden;
+  EstacionSimulada* estaciones;
+  int nEstaciones;
+  long long nAutos;
+  const Escenario* escenario;
+  uint64_t relojNs;     // Hora virtual actual
+  // Resultados por auto (acumulados, para no guardar nada por auto)
+  long long autosTerminados, autosQueEsperaron;
+  uint64_t esperaMaximaNs;
+  double esperaTotalNs, sistemaTotalNs; // En double: con millones de autos no entran en 64 bits
+} Simulacion;
+
+// Agrega un fin de tarea a la agenda (sube en el heap hasta su lugar)
+static void simulacionAgendar(Simulacion* sim, FinDeTarea evento) {
+  evento.orden = sim->siguienteOrden++;
+  int i = sim->enAgenda++;
+  while (i > 0) {
+    int padre = (i - 1) / 2;
+    FinDeTarea* p = &sim->agenda[padre];
+    if (p->tiempoNs < evento.tiempoNs || (p->tiempoNs == evento.tiempoNs && p->orden < evento.orden)) {
+      break;
+    }
+    sim->agenda[i] = *p;
+    i = padre;
+  }
+  sim->agenda[i] = evento;
+}
+
+// Saca el fin de tarea más próximo de la agenda (baja el último hasta su lugar)
+static FinDeTarea simulacionSiguiente(Simulacion* sim) {
+  FinDeTarea primero = sim->agenda[0];
+  FinDeTarea ultimo = sim->agenda[--sim->enAgenda];
+  int i = 0;
+  while (1) {
+    int hijo = 2 * i + 1;
+    if (hijo >= sim->enAgenda) {
+      break;
+    }
+    FinDeTarea* h = &sim->agenda[hijo];
+    if (hijo + 1 < sim->enAgenda &&
+        (h[1].tiempoNs < h->tiempoNs || (h[1].tiempoNs == h->tiempoNs && h[1].orden < h->orden))) {
+      h++;
+      hijo++;
+    }
+    if (ultimo.tiempoNs < h->tiempoNs || (ultimo.tiempoNs == h->tiempoNs && ultimo.orden < h->orden)) {
+      break;
+    }
+    sim->agenda[i] = *h;
+    i = hijo;
+  }
+  sim->agenda[i] = ultimo;
+  return primero;
+}
+
+// Primera tarea que hace el auto a partir de "desde" (o SIN_TAREA si no le queda ninguna)
+static int simulacionProximaTarea(const Simulacion* sim, int indiceAuto, int desde) {
+  for (int i = desde; i < sim->escenario->nTareas; i++) {
+    if (escenarioHaceTarea(sim->escenario, indiceAuto, i)) {
+      return i;
+    }
+  }
+  return SIN_TAREA;
+}
+
+// El auto entra a la estación a la hora actual y empieza su primera tarea
+static void simulacionIngresar(Simulacion* sim, int indiceAuto, int estacion) {
+  uint64_t espera = sim->relojNs; // Todos llegaron en t = 0
+  sim->esperaTotalNs += espera;
+  if (espera > sim->esperaMaximaNs) {
+    sim->esperaMaximaNs = espera;
+  }
+  sim->estaciones[estacion - 1].plazasLibres--;
+  registrarEventoEn(sim->relojNs, EVENTO_INGRESO, indiceAuto, estacion, 0);
+  int tarea = simulacionProximaTarea(sim, indiceAuto, 0);
+  FinDeTarea fin = {sim->relojNs, 0, indiceAuto, estacion, (uint8_t)tarea, sim->relojNs};
+  if (tarea != SIN_TAREA) {
+    registrarEventoEn(sim->relojNs, EVENTO_INICIO_TAREA, indiceAuto, estacion, tarea);
+    fin.tiempoNs += escenarioDuracionNs(sim->escenario, indiceAuto, tarea);
+  }
+  simulacionAgendar(sim, fin);
+}
+
+/* ---------------------------------------------------------
+Corre la simulación completa del escenario. Devuelve -1 si no
+hay memoria. Los resultados quedan en "sim" para
+simulacionImprimirResumen.
+------------------------------------------------------------*/
+static int simulacionEjecutar(Simulacion* sim, const Escenario* escenario) {
+  long long nAutos = escenario->nAutos;
+  int nEstaciones = escenario->nEstaciones;
+  *sim = (Simulacion){0};
+  sim->nAutos = nAutos;
+  sim->nEstaciones = nEstaciones;
+  sim->escenario = escenario;
+  sim->agenda = malloc(sizeof(FinDeTarea) * ((size_t)escenario->plazasTotales + 1));
+  sim->estaciones = calloc(nEstaciones, sizeof(EstacionSimulada));
+  if (!sim->agenda || !sim->estaciones) {
+    free(sim->agenda);
+    free(sim->estaciones);
+    return -1;
+  }
+  for (int i = 0; i < nEstaciones; i++) {
+    sim->estaciones[i].plazasLibres = sim->estaciones[i].capacidad = escenario->capacidades[i];
+  }
+
+  // En t = 0 llegan todos: los primeros ocupan las plazas (primera estación con lugar)
+  // y el resto queda en fila
+  long long siguienteEnFila = 1;
+  for (int estacion = 1; estacion <= nEstaciones && siguienteEnFila <= nAutos; estacion++) {
+    while (sim->estaciones[estacion - 1].plazasLibres > 0 && siguienteEnFila <= nAutos) {
+      simulacionIngresar(sim, (int)siguienteEnFila++, estacion);
+    }
+  }
+  for (long long i = siguienteEnFila; i <= nAutos; i++) {
+    registrarEventoEn(0, EVENTO_ESPERA, (int)i, 0, 0);
+  }
+  sim->autosQueEsperaron = nAutos - siguienteEnFila + 1;
+
+  // Avanza el reloj de fin de tarea en fin de tarea
+  while (sim->enAgenda > 0) {
+    FinDeTarea fin = simulacionSiguiente(sim);
+    sim->relojNs = fin.tiempoNs;
+    if (fin.tarea != SIN_TAREA) {
+      registrarEventoEn(sim->relojNs, EVENTO_FIN_TAREA, fin.indiceAuto, fin.estacion, fin.tarea);
+      int siguiente = simulacionProximaTarea(sim, fin.indiceAuto, fin.tarea + 1);
+      if (siguiente != SIN_TAREA) {
+        // Empieza la siguiente tarea en la misma estación
+        registrarEventoEn(sim->relojNs, EVENTO_INICIO_TAREA, fin.indiceAuto, fin.estacion, siguiente);
+        fin.tarea = (uint8_t)siguiente;
+        fin.tiempoNs += escenarioDuracionNs(sim->escenario, fin.indiceAuto, siguiente);
+        simulacionAgendar(sim, fin);
+        continue;
+      }
+    }
+
+    // Terminó todo: libera la plaza y entra el primero de la fila
+    registrarEventoEn(sim->relojNs, EVENTO_FIN_TODO, fin.indiceAuto, fin.estacion, 0);
+    EstacionSimulada* e = &sim->estaciones[fin.estacion - 1];
+    e->plazasLibres++;
+    e->autosAtendidos++;
+    e->ocupadoNs += sim->relojNs - fin.ingresoNs;
+    sim->autosTerminados++;
+    sim->sistemaTotalNs += sim->relojNs;
+    if (siguienteEnFila <= nAutos) {
+      simulacionIngresar(sim, (int)siguienteEnFila++, fin.estacion);
+    }
+  }
+  return 0;
+}
+
+// Imprime los resultados por estación (una línea cada una hasta MAX_ESTACIONES_DETALLE)
+// y los promedios por auto, en segundos virtuales
+static void simulacionImprimirResumen(const Simulacion* sim) {
+  double duracion = sim->relojNs / 1e9;
+  double utilizacion = 0, utilizacionCuadrado = 0, utilizacionMinima = 100, utilizacionMaxima = 0;
+  int conPlazas = 0;
+  printf("Simulación: %lld autos en %.3f s de tiempo virtual\n", sim->autosTerminados, duracion);
+  for (int i = 0; i < sim->nEstaciones; i++) {
+    const EstacionSimulada* e = &sim->estaciones[i];
+    double u = sim->relojNs > 0 && e->capacidad > 0
+        ? 100.0 * e->ocupadoNs / ((double)sim->relojNs * e->capacidad) : 0;
+    if (sim->nEstaciones <= MAX_ESTACIONES_DETALLE) {
+      printf("Estación %d: %lld autos atendidos, utilización %.1f%%\n", i + 1, e->autosAtendidos, u);
+    }
+    if (e->capacidad == 0) {
+      continue; // Estación cerrada: no cuenta para la utilización
+    }
+    conPlazas++;
+    utilizacion += u;
+    utilizacionCuadrado += u * u;
+    if (u < utilizacionMinima) {
+      utilizacionMinima = u;
+    }
+    if (u > utilizacionMaxima) {
+      utilizacionMaxima = u;
+    }
+  }
+  if (conPlazas > 0) {
+    double media = utilizacion / conPlazas;
+    printf("Utilización por estación: media %.1f%%, desvío %.1f%%, mínima %.1f%%, máxima %.1f%%\n", media,
+           sqrt(fmax(0, utilizacionCuadrado / conPlazas - media * media)), utilizacionMinima, utilizacionMaxima);
+  }
+  if (sim->autosTerminados > 0) {
+    printf("Espera promedio %.3f s (máxima %.3f s, %lld autos esperaron), tiempo promedio en el sistema %.3f s\n",
+           sim->esperaTotalNs / 1e9 / sim->autosTerminados, sim->esperaMaximaNs / 1e9,
+           sim->autosQueEsperaron, sim->sistemaTotalNs / 1e9 / sim->autosTerminados);
+  }
+}
+
+static void simulacionDestruir(Simulacion* sim) {
+  free(sim->agenda);
+  free(sim->estaciones);
+}
+
+#endif
@@ -0,0 +1,170 @@
+// TABLERO DE MÉTRICAS EN VIVO EN MEMORIA COMPARTIDA (--tablero <nombre>)
+//
+// scriptMetricas.py solo ve el proceso desde afuera (memoria, CPU, hilos); no sabe
+// cuántos autos están esperando, cuántos hay en cada estación ni cuántos terminaron.
+// Con --tablero /nombre el programa crea un segmento POSIX (shm_open, queda en
+// /dev/shm/nombre) con contadores atómicos que va actualizando mientras corre, y
+// cualquier otro proceso lo puede leer en cualquier momento sin candados y sin tocar
+// la salida del programa (ver Herramientas/leerTablero.py).
+//
+// Diseño del segmento: bloques de 64 bytes (una línea de caché cada uno, para que
+// los hilos que tocan contadores distintos no se peleen la misma línea):
+//
+//   bloque 0      cabecera: firma, versión, nEstaciones, nAutos, inicioNs, terminado
+//   bloque 1      autos que llegaron
+//   bloque 2      autos que entraron a una estación
+//   bloque 3      autos que terminaron todo
+//   bloque 4      espera acumulada (ns) de los que entraron
+//   bloque 5      autos rechazados por la sala llena (llegadas abiertas, ver llegadas.h)
+//   bloque 6      autos descartados de la sala para hacer lugar a otro
+//   bloque 7      autos en la sala de espera ahora (solo con llegadas abiertas)
+//   bloque 8 + i  estación i+1: autos en servicio ahora y autos atendidos
+//
+// Los que esperan en este momento son llegados - admitidos - rechazados - descartados
+// (con llegadas abiertas, todos ellos están en la sala). La corrida termina con
+// llegados = completados + rechazados + descartados = nAutos. Todos los valores son
+// enteros de 64 bits en el orden de bytes de la máquina. El segmento queda después
+// de que el programa termina (con terminado = 1) para poder leer los totales; lo
+// borra quien lo lee (leerTablero.py --borrar, scriptMetricas.py) o rm /dev/shm/nombre.
+
+#ifndef TABLERO_H
+#define TABLERO_H
+
+#include <fcntl.h>     // Para O_CREAT, O_RDWR
+#include <stdatomic.h> // Para los contadores
+#include <stddef.h>    // Para offsetof
+#include <stdint.h>    // Para uint64_t
+#include <sys/mman.h>  // Para shm_open, mmap
+#include <unistd.h>    // Para ftruncate, close
+#include "registro.h"  // Para relojNs
+
+#define TABLERO_FIRMA 0x314c4241544c5354ull // "TSLTABL1" leído como entero little-endian
+#define TABLERO_VERSION 3
+#define TABLERO_LINEA 64
+
+typedef struct {
+  _Alignas(TABLERO_LINEA) uint64_t firma;
+  uint32_t version;
+  int32_t nEstaciones;
+  int64_t nAutos;
+  uint64_t inicioNs;   // relojNs() cuando se creó (CLOCK_MONOTONIC)
+  atomic_llong terminado; // 1 cuando ya terminaron todos los autos
+} TableroCabecera;
+
+typedef struct {
+  _Alignas(TABLERO_LINEA) atomic_llong valor;
+} TableroContador;
+
+typedef struct {
+  _Alignas(TABLERO_LINEA) atomic_llong enServicio;
+  atomic_llong atendidos;
+} TableroEstacion;
+
+typedef struct {
+  TableroCabecera cabecera;
+  TableroContador llegados;
+  TableroContador admitidos;
+  TableroContador completados;
+  TableroContador esperaNs;
+  TableroContador rechazados;
+  TableroContador descartados;
+  TableroContador sala;
+  TableroEstacion estaciones[]; // nEstaciones
+} Tablero;
+
+// El lector en Python cuenta con estos desplazamientos (bloque * 64)
+_Static_assert(sizeof(TableroCabecera) == TABLERO_LINEA, "cabecera de una línea");
+_Static_assert(offsetof(Tablero, estaciones) == 8 * TABLERO_LINEA, "estaciones desde el bloque 8");
+
+// Segmento mapeado, o NULL sin --tablero (entonces las funciones no hacen nada)
+static Tablero* tablero = NULL;
+static size_t tamTablero = 0;
+
+/* ---------------------------------------------------------
+Crea (o vacía) el segmento "nombre" (por ejemplo "/teslas")
+con lugar para nEstaciones. Devuelve -1 si no se pudo.
+------------------------------------------------------------*/
+static int tableroIniciar(const char* nombre, int nEstaciones, int nAutos) {
+  int fd = shm_open(nombre, O_CREAT | O_RDWR, 0644);
+  if (fd < 0) {
+    return -1;
+  }
+  tamTablero = sizeof(Tablero) + sizeof(TableroEstacion) * (nEstaciones > 0 ? nEstaciones : 0);
+  // ftruncate a 0 y después al tamaño: si existía de una corrida anterior queda en ceros
+  if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)tamTablero) != 0) {
+    close(fd);
+    return -1;
+  }
+  void* mapa = mmap(NULL, tamTablero, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapa == MAP_FAILED) {
+    return -1;
+  }
+  tablero = mapa;
+  tablero->cabecera.version = TABLERO_VERSION;
+  tablero->cabecera.nEstaciones = nEstaciones;
+  tablero->cabecera.nAutos = nAutos;
+  tablero->cabecera.inicioNs = relojNs();
+  // La firma va última: un lector que la ve ya puede confiar en el resto de la cabecera
+  atomic_thread_fence(memory_order_release);
+  tablero->cabecera.firma = TABLERO_FIRMA;
+  return 0;
+}
+
+// Llegó un auto (empieza a esperar plaza, o con llegadas abiertas pasa por la sala)
+static inline void tableroLlegada(void) {
+  if (tablero) {
+    atomic_fetch_add_explicit(&tablero->llegados.valor, 1, memory_order_relaxed);
+  }
+}
+
+// El auto entró a la estación (1..n) después de esperar "esperaNs"
+static inline void tableroIngreso(int estacion, uint64_t esperaNs) {
+  if (tablero) {
+    atomic_fetch_add_explicit(&tablero->estaciones[estacion - 1].enServicio, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&tablero->esperaNs.valor, (long long)esperaNs, memory_order_relaxed);
+    atomic_fetch_add_explicit(&tablero->admitidos.valor, 1, memory_order_relaxed);
+  }
+}
+
+// El auto terminó todo y deja la estación (1..n)
+static inline void tableroSalida(int estacion) {
+  if (tablero) {
+    atomic_fetch_sub_explicit(&tablero->estaciones[estacion - 1].enServicio, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&tablero->estaciones[estacion - 1].atendidos, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&tablero->completados.valor, 1, memory_order_relaxed);
+  }
+}
+
+// La sala estaba llena y el auto se fue sin atenderse (rechazado)
+static inline void tableroRechazo(void) {
+  if (tablero) {
+    atomic_fetch_add_explicit(&tablero->rechazados.valor, 1, memory_order_relaxed);
+  }
+}
+
+// Echaron de la sala al auto que más esperó para hacer lugar a otro (descartado)
+static inline void tableroDescarte(void) {
+  if (tablero) {
+    atomic_fetch_add_explicit(&tablero->descartados.valor, 1, memory_order_relaxed);
+  }
+}
+
+// Autos en la sala de espera ahora (se publica el valor, no una diferencia)
+static inline void tableroSala(long long autos) {
+  if (tablero) {
+    atomic_store_explicit(&tablero->sala.valor, autos, memory_order_relaxed);
+  }
+}
+
+// Marca el tablero como terminado (llamar cuando ya terminaron todos los autos)
+static void tableroTerminar(void) {
+  if (!tablero) {
+    return;
+  }
+  atomic_store(&tablero->cabecera.terminado, 1);
+  munmap(tablero, tamTablero);
+  tablero = NULL;
+}
+
+#endif
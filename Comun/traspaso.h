@@ -0,0 +1,113 @@
+// TRASPASO DIRECTO DE PLAZAS A LOS AUTOS QUE ESPERAN
+//
+// Antes, cada auto que terminaba hacía sem_post(&semasEsperaAutos) aunque nadie
+// esperara: el semáforo juntaba permisos viejos, y el auto despertado volvía a
+// recorrer todas las estaciones con sem_trywait para encontrar (o no) una plaza.
+//
+// Ahora los autos que no encuentran lugar se anotan en una fila FIFO y quien sale
+// de una estación le entrega SU plaza (el número de estación) al que más tiempo
+// lleva esperando: la plaza no vuelve a quedar libre, nadie más puede ganársela y
+// el despertado entra sin buscar. Solo si la fila está vacía se libera la plaza.
+//
+// Cada auto espera en su propia casilla (una palabra futex, como en secuenciador.h),
+// así que cada traspaso despierta a un único hilo y solo si de verdad está dormido.
+//
+// Con --prioridades la fila tiene una sub-fila por clase y la plaza va al auto con el
+// plazo más próximo en lugar de al más viejo (ver prioridades.h).
+
+#ifndef TRASPASO_H
+#define TRASPASO_H
+
+#include <pthread.h>     // Para el mutex de la fila
+#include <stdlib.h>      // Para calloc, free
+#include "futex.h"       // Para futexEsperar, futexDespertar
+#include "prioridades.h" // Para la fila con una sub-fila por clase
+
+// Estados de la casilla de un auto anotado (si no, la casilla tiene su estación, 1..n)
+#define TRASPASO_ESPERA 0  // Todavía no le dieron plaza
+#define TRASPASO_DUERME -1 // Sin plaza y bloqueado en el futex
+
+// Cómo toma el programa una plaza sin bloquearse (estación 1..n o -1) y cómo la libera
+typedef int (*TomarPlazaFn)(void);
+typedef void (*LiberarPlazaFn)(int estacion);
+
+typedef struct {
+  pthread_mutex_t mutex; // Protege la fila (y ordena liberar contra anotarse)
+  atomic_int* casillas;  // casillas[i] = estado o estación traspasada al auto i+1
+  EnFila* anotados;      // anotados[i] = lugar del auto i+1 en la fila
+  FilaPrioridades fila;
+} Traspaso;
+
+// Reserva una casilla por auto. Devuelve -1 si no hay memoria.
+static int traspasoIniciar(Traspaso* t, int nAutos) {
+  pthread_mutex_init(&t->mutex, NULL);
+  filaPrioridadesIniciar(&t->fila);
+  t->casillas = calloc(nAutos > 0 ? nAutos : 1, sizeof(atomic_int));
+  t->anotados = calloc(nAutos > 0 ? nAutos : 1, sizeof(EnFila));
+  if (!t->casillas || !t->anotados) {
+    free(t->casillas);
+    free(t->anotados);
+    return -1;
+  }
+  return 0;
+}
+
+static void traspasoDestruir(Traspaso* t) {
+  pthread_mutex_destroy(&t->mutex);
+  free(t->casillas);
+  free(t->anotados);
+}
+
+/* ---------------------------------------------------------
+El auto "indiceAuto" (1..nAutos) no encontró lugar. Vuelve a
+probar con la fila tomada (por si alguien liberó una plaza
+entre medio) y, si sigue sin lugar, se anota al final (de su
+clase) y duerme hasta que le traspasen una. Devuelve la estación (1..n).
+------------------------------------------------------------*/
+static int traspasoEsperar(Traspaso* t, int indiceAuto, TomarPlazaFn tomar) {
+  pthread_mutex_lock(&t->mutex);
+  int estacion = tomar();
+  if (estacion > 0) {
+    pthread_mutex_unlock(&t->mutex);
+    return estacion;
+  }
+  atomic_int* casilla = &t->casillas[indiceAuto - 1];
+  atomic_store_explicit(casilla, TRASPASO_ESPERA, memory_order_relaxed);
+  filaPrioridadesPoner(&t->fila, &t->anotados[indiceAuto - 1], indiceAuto);
+  pthread_mutex_unlock(&t->mutex);
+
+  // Marco que voy a dormir para que quien me traspase sepa que tiene que despertarme
+  estacion = TRASPASO_ESPERA;
+  if (!atomic_compare_exchange_strong(casilla, &estacion, TRASPASO_DUERME)) {
+    return estacion; // Ya me habían traspasado una plaza
+  }
+  while ((estacion = atomic_load(casilla)) <= 0) {
+    futexEsperar(casilla, TRASPASO_DUERME);
+  }
+  return estacion;
+}
+
+/* ---------------------------------------------------------
+El auto sale de "estacion" (1..n): si hay autos anotados le
+pasa la plaza al primero de la fila (el de plazo más próximo
+con --prioridades) y lo despierta; si no hay nadie, la libera
+con "liberar" (con la fila tomada, para que nadie se anote
+sin ver la plaza libre).
+------------------------------------------------------------*/
+static void traspasoEntregar(Traspaso* t, int estacion, LiberarPlazaFn liberar) {
+  pthread_mutex_lock(&t->mutex);
+  EnFila* elegido = filaPrioridadesSacar(&t->fila);
+  if (!elegido) {
+    liberar(estacion);
+    pthread_mutex_unlock(&t->mutex);
+    return;
+  }
+  pthread_mutex_unlock(&t->mutex);
+
+  atomic_int* casilla = &t->casillas[elegido - t->anotados];
+  if (atomic_exchange(casilla, estacion) == TRASPASO_DUERME) {
+    futexDespertar(casilla, 1);
+  }
+}
+
+#endif
@@ -0,0 +1,23 @@
+// CENTROS DE MANTENIMIENTO DE TESLAS CON COLAS POR ESTACIÓN (Y ROBO DE AUTOS) SIN SEGURO DE ENTRADA ORDENADA
+//
+// Cada estación tiene su propia cola FIFO de autos esperando y, si su cola está
+// vacía, le roba el primer auto a la estación con la cola más larga
+// (Motor/estrategiaColas.h).
+//
+// El núcleo es el del motor (Motor/mantenimientoDeTeslasMotor.c, ver Motor/programa.h).
+
+#define _XOPEN_SOURCE 600
+#include "../Comun/opciones.h" // Para OPCION_*
+#include "../Motor/programa.h" // Para Programa
+
+#define PROGRAMA_MOTOR
+static const Programa programa = {
+  .estrategia = "colas",
+  .opciones = OPCIONES_COMUNES | OPCION_POOL,
+  .formatos = {
+    [EVENTO_INICIO_TAREA] = "Vehículo %d ha iniciado el mantenimiento de la %s en la estación de mantenimiento %d.\n",
+    [EVENTO_FIN_TAREA] = "Vehículo %d ha completado el mantenimiento de la %s en la estación de mantenimiento %d.\n",
+  },
+};
+
+#include "../Motor/mantenimientoDeTeslasMotor.c"
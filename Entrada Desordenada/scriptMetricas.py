@@ -5,20 +5,107 @@ import resource
 import psutil
 import threading
 import glob
+import sys
+import queue
 import pandas as pd
 from datetime import datetime
 from collections import defaultdict
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+# Lector de la traza binaria (--traza) de los programas
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Herramientas"))
+from decodificarTraza import leer_traza
+# Lector del tablero en memoria compartida (--tablero) con los contadores en vivo del programa
+from leerTablero import abrir_tablero, leer_tablero, borrar_tablero
+
+# Todas las variantes son el mismo motor con otra estrategia: se compila una sola vez
+MOTOR_C = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Motor", "mantenimientoDeTeslasMotor.c")
+# Orden de entrada de los autos en las corridas de esta carpeta
+ENTRADA = "desordenada"
+# Cada variante: nombre con el que se reporta y opciones del motor que la eligen
+VARIANTES = [
+    ("semaforos", ["--estrategia", "semaforos"]),
+    ("condicion", ["--estrategia", "condicion"]),
+    ("espera", ["--estrategia", "espera"]),
+    ("barrera", ["--estrategia", "barrera"]),
+    ("colas", ["--estrategia", "colas"]),
+    ("atomica", ["--estrategia", "atomica"]),
+    ("combinada", ["--estrategia", "combinada"]),
+    ("fibras", ["--fibras"]),
+]
+# Opciones de gcc con las que se compila el motor (una sola vez, ver compilar_programa)
+FLAGS_COMPILACION = ["-O2"]
+# Carpeta donde quedan los ejecutables compilados entre una corrida del script y la siguiente
+DIRECTORIO_BINARIOS = "binarios"
+# CPUs que se le dan a cada corrida: las corridas simultáneas van en conjuntos de CPUs disjuntos
+CPUS_POR_CORRIDA = 2
+# En máquinas con varios nodos NUMA cada conjunto toma CPUs de todos los nodos, así la
+# comparación con y sin --afinidad mide lo que cuesta que los hilos crucen de socket
+REPARTIR_ENTRE_NODOS = True
+
+def compilar_programa(codigo_c, flags=FLAGS_COMPILACION):
+    """Compila el programa una sola vez con las opciones dadas y devuelve la ruta del ejecutable.
+    Si ya hay un ejecutable más nuevo que el .c y que los headers de su carpeta y de Comun/, se reusa."""
+    os.makedirs(DIRECTORIO_BINARIOS, exist_ok=True)
+    nombre = os.path.splitext(os.path.basename(codigo_c))[0]
+    sufijo = "".join(f.replace("-", "_").replace("=", "") for f in flags)
+    ejecutable = os.path.join(DIRECTORIO_BINARIOS, f"{nombre}{sufijo}")
+    carpeta = os.path.dirname(os.path.abspath(codigo_c))
+    headers = glob.glob(os.path.join(carpeta, "*.h")) + glob.glob(os.path.join(carpeta, "..", "Comun", "*.h"))
+    fuentes = [codigo_c, *headers]
+    if os.path.exists(ejecutable) and os.path.getmtime(ejecutable) >= max(os.path.getmtime(f) for f in fuentes):
+        return ejecutable
+    compilacion = subprocess.run(["gcc", *flags, "-pthread", codigo_c, "-o", ejecutable, "-lm"])
+    if compilacion.returncode != 0:
+        raise RuntimeError(f"Fallo al compilar el programa {codigo_c}")
+    return ejecutable
+
+def cpus_por_nodo():
+    """Lista de CPUs de cada nodo NUMA según /sys (un solo nodo con todas si no se puede leer)"""
+    nodos = []
+    for archivo in sorted(glob.glob("/sys/devices/system/node/node[0-9]*/cpulist")):
+        cpus = []
+        with open(archivo) as f:
+            for rango in f.read().strip().split(","):
+                if rango:
+                    desde, _, hasta = rango.partition("-")
+                    cpus.extend(range(int(desde), int(hasta or desde) + 1))
+        if cpus:
+            nodos.append(cpus)
+    return nodos
+
+def conjuntos_de_cpus(cpus_por_corrida=CPUS_POR_CORRIDA, repartir_entre_nodos=REPARTIR_ENTRE_NODOS):
+    """Parte las CPUs que puede usar el script en conjuntos disjuntos de cpus_por_corrida CPUs.
+    Cada conjunto corre una sola corrida a la vez, así las corridas simultáneas no se pisan.
+    Con repartir_entre_nodos las CPUs se alternan entre nodos NUMA antes de partirlas."""
+    cpus = sorted(os.sched_getaffinity(0))
+    if repartir_entre_nodos:
+        permitidas = set(cpus)
+        nodos = [[c for c in nodo if c in permitidas] for nodo in cpus_por_nodo()]
+        nodos = [nodo for nodo in nodos if nodo]
+        if len(nodos) > 1:
+            # Una de cada nodo por vuelta: nodo0[0], nodo1[0], nodo0[1], nodo1[1], ...
+            intercaladas = [nodo[i] for i in range(max(map(len, nodos))) for nodo in nodos if i < len(nodo)]
+            cpus = intercaladas + [c for c in cpus if c not in set(intercaladas)]
+    cpus_por_corrida = max(1, min(cpus_por_corrida, len(cpus)))
+    return [set(cpus[i:i + cpus_por_corrida]) for i in range(0, len(cpus) - cpus_por_corrida + 1, cpus_por_corrida)]
 
 def escribir_configuracion(nombre_archivo, carros, estaciones, carros_por_estacion):
     with open(nombre_archivo, "w") as archivo:
         archivo.write(f"{carros}\n{estaciones}\n{carros_por_estacion}\n")
 
-def monitorear_recursos(pid, metricas, stop_event):
-    """Monitorea CPU, memoria y otros recursos del proceso"""
+def monitorear_recursos(pid, metricas, stop_event, nombre_tablero=None):
+    """Monitorea CPU, memoria y otros recursos del proceso.
+    Con nombre_tablero también muestrea cuántos autos están esperando plaza (lo publica el programa)."""
+    tablero = None
     try:
         proceso = psutil.Process(pid)
         while not stop_event.is_set():
             try:
+                if nombre_tablero and tablero is None:
+                    tablero = abrir_tablero(nombre_tablero)  # El programa lo crea al arrancar
+                if tablero is not None:
+                    metricas['esperando_samples'].append(leer_tablero(tablero)['esperando'])
                 cpu_percent = proceso.cpu_percent()
                 memoria_info = proceso.memory_info()
                 memoria_mb = memoria_info.rss / 1024 / 1024
@@ -27,65 +114,80 @@ def monitorear_recursos(pid, metricas, stop_event):
                 metricas['memoria_samples'].append(memoria_mb)
                 metricas['num_threads'].append(proceso.num_threads())
                 
-                time.sleep(0.1)  # Muestreo cada 100ms
+                stop_event.wait(0.1)  # Muestreo cada 100ms (sin demorar el final de la corrida)
             except (psutil.NoSuchProcess, psutil.AccessDenied):
                 break
     except psutil.NoSuchProcess:
         pass
+    if tablero is not None:
+        tablero.close()
 
-def ejecutar_programa(codigo_c, archivo_config, nombre_programa):
-    """Ejecuta un programa C específico y retorna sus métricas"""
-    ejecutable = f"./ejecutable_{nombre_programa}"
-    compilacion = subprocess.run(["gcc", "-pthread", codigo_c, "-o", ejecutable])
-    if compilacion.returncode != 0:
-        raise RuntimeError(f"Fallo al compilar el programa {codigo_c}")
+def ejecutar_programa(ejecutable, archivo_config, nombre_programa, opciones=(), cpus=None):
+    """Ejecuta un programa ya compilado (con sus opciones de línea de comandos) y retorna sus métricas.
+    Los eventos se piden en una traza binaria (--traza), así el throughput no depende de formatear texto.
+    Con cpus, el programa corre fijado (con taskset) a ese conjunto de CPUs."""
+    # Nombre único: puede haber varias corridas del mismo programa a la vez
+    archivo_traza = f"./traza_{nombre_programa}_{threading.get_ident()}.bin"
+    nombre_tablero = f"/teslas_{os.getpid()}_{threading.get_ident()}"
 
     # Preparar métricas de monitoreo
     metricas = {
         'cpu_samples': [],
         'memoria_samples': [],
-        'num_threads': []
+        'num_threads': [],
+        'esperando_samples': []
     }
     
     inicio = time.time()
-    uso_inicio = resource.getrusage(resource.RUSAGE_CHILDREN)
 
-    # Ejecutar proceso
-    proceso = subprocess.Popen([ejecutable, archivo_config], 
-                              stdout=subprocess.PIPE, 
-                              stderr=subprocess.PIPE)
+    # Ejecutar proceso (la salida de texto no se usa: los eventos van a la traza)
+    # Con cpus, taskset fija la afinidad antes del exec: así la heredan todos los hilos
+    # desde el primero (preexec_fn no es seguro con los hilos de este script)
+    fijar_cpus = ["taskset", "-c", ",".join(map(str, sorted(cpus)))] if cpus else []
+    proceso = subprocess.Popen([*fijar_cpus, ejecutable, archivo_config, *opciones, "--traza", archivo_traza,
+                               "--tablero", nombre_tablero], 
+                              stdout=subprocess.DEVNULL, 
+                              stderr=subprocess.DEVNULL)
     
     # Iniciar monitoreo de recursos
     stop_event = threading.Event()
     monitor_thread = threading.Thread(
         target=monitorear_recursos, 
-        args=(proceso.pid, metricas, stop_event)
+        args=(proceso.pid, metricas, stop_event, nombre_tablero)
     )
     monitor_thread.start()
     
-    # Esperar a que termine el proceso
-    salida, error = proceso.communicate()
+    # Esperar a que termine el proceso. wait4 da el uso de CPU de este hijo solo
+    # (RUSAGE_CHILDREN sumaría el de las otras corridas que terminen mientras tanto)
+    _, estado, uso = os.wait4(proceso.pid, 0)
+    proceso.returncode = os.waitstatus_to_exitcode(estado)
+    # Antes de esperar al monitor, que puede tardar hasta una muestra (100ms) en enterarse
+    fin = time.time()
     
     # Detener monitoreo
     stop_event.set()
     monitor_thread.join()
     
-    fin = time.time()
-    uso_fin = resource.getrusage(resource.RUSAGE_CHILDREN)
+    # Totales del tablero (queda con los valores finales después de que el programa termina)
+    tablero = abrir_tablero(nombre_tablero)
+    final_tablero = leer_tablero(tablero) if tablero is not None else None
+    if tablero is not None:
+        tablero.close()
+    borrar_tablero(nombre_tablero)
 
-    # Limpiar ejecutable temporal
-    if os.path.exists(ejecutable):
-        os.remove(ejecutable)
+    if proceso.returncode != 0:
+        raise RuntimeError(f"{nombre_programa} terminó con código {proceso.returncode}")
 
     # Calcular métricas básicas
     tiempo_total = fin - inicio  # Latencia (wall-clock time)
-    tiempo_usuario = uso_fin.ru_utime - uso_inicio.ru_utime
-    tiempo_sistema = uso_fin.ru_stime - uso_inicio.ru_stime
+    tiempo_usuario = uso.ru_utime
+    tiempo_sistema = uso.ru_stime
     tiempo_cpu_total = tiempo_usuario + tiempo_sistema
 
-    # Procesar salida para throughput
-    salida_decodificada = salida.decode()
-    lineas_procesadas = len(salida_decodificada.splitlines())
+    # Procesar la traza para throughput (cada evento equivale a una línea de la salida de texto)
+    _, _, eventos = leer_traza(archivo_traza)
+    lineas_procesadas = len(eventos)
+    os.remove(archivo_traza)
     
     # Throughput: operaciones por segundo
     throughput = lineas_procesadas / tiempo_total if tiempo_total > 0 else 0
@@ -98,6 +200,11 @@ def ejecutar_programa(codigo_c, archivo_config, nombre_programa):
     memoria_promedio = sum(metricas['memoria_samples']) / len(metricas['memoria_samples']) if metricas['memoria_samples'] else 0
     memoria_maxima = max(metricas['memoria_samples']) if metricas['memoria_samples'] else 0
     threads_promedio = sum(metricas['num_threads']) / len(metricas['num_threads']) if metricas['num_threads'] else 0
+    esperando_promedio = sum(metricas['esperando_samples']) / len(metricas['esperando_samples']) if metricas['esperando_samples'] else 0
+    esperando_maximo = max(metricas['esperando_samples']) if metricas['esperando_samples'] else 0
+    # Espera media para conseguir plaza, medida por el propio programa
+    espera_media = (final_tablero['espera_acumulada_s'] / final_tablero['admitidos']
+                    if final_tablero and final_tablero['admitidos'] else 0)
     
     return {
         'latencia': tiempo_total,
@@ -107,6 +214,9 @@ def ejecutar_programa(codigo_c, archivo_config, nombre_programa):
         'memoria_promedio_mb': memoria_promedio,
         'memoria_maxima_mb': memoria_maxima,
         'threads_promedio': threads_promedio,
+        'esperando_promedio': esperando_promedio,
+        'esperando_maximo': esperando_maximo,
+        'espera_media': espera_media,
         'tiempo_usuario': tiempo_usuario,
         'tiempo_sistema': tiempo_sistema,
         'lineas_procesadas': lineas_procesadas
@@ -132,12 +242,6 @@ def calcular_estadisticas(valores):
         'desviacion': desviacion
     }
 
-def obtener_programas_c(directorio="."):
-    """Obtiene todos los archivos .c del directorio especificado"""
-    patron = os.path.join(directorio, "*.c")
-    archivos_c = glob.glob(patron)
-    return [os.path.basename(archivo) for archivo in archivos_c]
-
 def mostrar_tabla_detallada_programa(resultados, nombre_programa):
     print(f"\n" + "="*120)
     print(f"RESULTADOS DETALLADOS DEL BENCHMARK - PROGRAMA: {nombre_programa}")
@@ -181,6 +285,12 @@ def mostrar_tabla_detallada_programa(resultados, nombre_programa):
         print(f"\nTHREADS:")
         print(f"  Promedio: {thread_stats['promedio']:.1f}")
 
+        # Cola de espera (del tablero en memoria compartida)
+        print(f"\nAUTOS ESPERANDO PLAZA:")
+        print(f"  Promedio: {r['esperando_stats']['promedio']:.1f}")
+        print(f"  Máximo:   {r['esperando_maximo']}")
+        print(f"  Espera media por auto: {r['espera_stats']['promedio']:.6f}s")
+
 def mostrar_tabla_resumen_programa(resultados, nombre_programa):
     print(f"\n" + "="*100)
     print(f"TABLA RESUMEN - PROGRAMA: {nombre_programa}")
@@ -252,7 +362,10 @@ def exportar_a_excel_csv(todos_los_resultados):
                 'CPU_DesvEst_pct': resultado['cpu_stats']['desviacion'],
                 'Memoria_Promedio_MB': resultado['memoria_stats']['promedio'],
                 'Memoria_Max_MB': resultado['memoria_stats']['max'],
-                'Threads_Promedio': resultado['threads_stats']['promedio']
+                'Threads_Promedio': resultado['threads_stats']['promedio'],
+                'Esperando_Promedio': resultado['esperando_stats']['promedio'],
+                'Esperando_Max': resultado['esperando_maximo'],
+                'Espera_Media_s': resultado['espera_stats']['promedio']
             }
             datos_resumen.append(fila)
     
@@ -446,47 +559,83 @@ if __name__ == "__main__":
     ]
     
     repeticiones = 5
-    directorio_programas = "."  # Cambia esto por la ruta de tu carpeta si es diferente
-    
-    # Obtener todos los programas C
-    programas_c = obtener_programas_c(directorio_programas)
-    
-    if not programas_c:
-        print(f"No se encontraron archivos .c en el directorio: {directorio_programas}")
-        exit(1)
-    
-    print(f"Programas C encontrados: {programas_c}")
+
+    # Modos de ejecución: cada lista son opciones extra que se pasan al motor.
+    # Sin y con --afinidad: hilos libres contra hilos fijados al núcleo (y nodo NUMA) de una estación.
+    modos = [[], ["--afinidad"]]
+
+    # Las variantes son estrategias del mismo motor, con la entrada de esta carpeta
+    variantes = [nombre for nombre, _ in VARIANTES]
+    opciones_variante = {nombre: [*opciones, "--entrada", ENTRADA] for nombre, opciones in VARIANTES}
+
+    print(f"Variantes del motor: {variantes} (entrada {ENTRADA})")
     print(f"Iniciando benchmark con {repeticiones} repeticiones por configuración")
     print(f"CPU cores disponibles: {os.cpu_count()}")
+
+    # El motor se compila una sola vez (y se reusa si no cambió desde la última vez)
+    motor = compilar_programa(MOTOR_C)
+    print(f"Motor compilado con {' '.join(FLAGS_COMPILACION)} en {DIRECTORIO_BINARIOS}/")
+
+    # Un archivo por configuración: las corridas simultáneas no comparten mantenimientoConfig.txt
+    archivos_config = {}
+    for carros, estaciones, carros_por_estacion in configuraciones:
+        archivo = f"mantenimientoConfig_{carros}_{estaciones}_{carros_por_estacion}.txt"
+        escribir_configuracion(archivo, carros, estaciones, carros_por_estacion)
+        archivos_config[(carros, estaciones, carros_por_estacion)] = archivo
+
+    # Todas las corridas (programa, modo, configuración, repetición) son independientes: se
+    # reparten entre los conjuntos de CPUs y cada conjunto corre una sola a la vez
+    conjuntos = conjuntos_de_cpus()
+    cpus_libres = queue.Queue()
+    for conjunto in conjuntos:
+        cpus_libres.put(conjunto)
+    print(f"Corridas en paralelo: {len(conjuntos)} (CPUs {', '.join(str(sorted(c)) for c in conjuntos)})")
+
+    def correr(variante, modo, config):
+        cpus = cpus_libres.get()
+        try:
+            return ejecutar_programa(motor, archivos_config[config], variante,
+                                     (*opciones_variante[variante], *modo), cpus)
+        finally:
+            cpus_libres.put(cpus)
+
+    corridas = [(p, tuple(m), config) for p in variantes for m in modos for config in configuraciones
+                for _ in range(repeticiones)]
+    resultados_por_corrida = defaultdict(list)
+    with ThreadPoolExecutor(max_workers=len(conjuntos)) as ejecutor:
+        futuros = {ejecutor.submit(correr, *corrida): corrida for corrida in corridas}
+        for hechas, futuro in enumerate(as_completed(futuros), 1):
+            variante, modo, (carros, estaciones, carros_por_estacion) = futuros[futuro]
+            etiqueta = " ".join([variante, *modo, f"{carros}C-{estaciones}E-{carros_por_estacion}CPE"])
+            try:
+                resultado = futuro.result()
+                resultados_por_corrida[futuros[futuro]].append(resultado)
+                print(f"  [{hechas}/{len(corridas)}] {etiqueta}: Latencia: {resultado['latencia']:.4f}s, "
+                      f"Throughput: {resultado['throughput']:.1f} ops/s")
+            except Exception as e:
+                print(f"  [{hechas}/{len(corridas)}] {etiqueta}: Error: {e}")
+
+    for archivo in archivos_config.values():
+        os.remove(archivo)
     
     # Diccionario para almacenar resultados de todos los programas
     todos_los_resultados = {}
 
     # Ejecutar benchmark para cada programa
-    for programa_c in programas_c:
-        nombre_programa = os.path.splitext(programa_c)[0]  # Quitar extensión .c
+    for variante, modo in [(p, m) for p in variantes for m in modos]:
+        corrida = (variante, tuple(modo))
+        if modo:
+            # El nombre con el que se reporta incluye las opciones usadas
+            variante = f"{variante} {' '.join(modo)}"
         print(f"\n" + "="*80)
-        print(f"INICIANDO BENCHMARK PARA: {programa_c}")
+        print(f"RESULTADOS DEL BENCHMARK PARA: {variante}")
         print("="*80)
         
         resultados_finales = []
         
         for carros, estaciones, carros_por_estacion in configuraciones:
-            print(f"\nEjecutando configuración: {carros} carros (hilos), {estaciones} estaciones, {carros_por_estacion} carros/estación")
-            escribir_configuracion("mantenimientoConfig.txt", carros, estaciones, carros_por_estacion)
-
-            # Listas para almacenar resultados de cada repetición
-            resultados_repeticiones = []
-
-            for i in range(repeticiones):
-                print(f"  Repetición {i+1}/{repeticiones}...", end=' ')
-                try:
-                    resultado = ejecutar_programa(programa_c, "mantenimientoConfig.txt", nombre_programa)
-                    resultados_repeticiones.append(resultado)
-                    print(f"Latencia: {resultado['latencia']:.4f}s, Throughput: {resultado['throughput']:.1f} ops/s")
-                except Exception as e:
-                    print(f"Error: {e}")
-                    continue
+            # Resultados de cada repetición (ya corridas arriba, en paralelo)
+            resultados_repeticiones = resultados_por_corrida[(*corrida, (carros, estaciones, carros_por_estacion))]
 
             if not resultados_repeticiones:
                 print(f"  ERROR: No se pudieron obtener resultados para esta configuración")
@@ -498,6 +647,8 @@ if __name__ == "__main__":
             cpus = [r['cpu_utilizacion'] for r in resultados_repeticiones]
             memorias = [r['memoria_promedio_mb'] for r in resultados_repeticiones]
             threads = [r['threads_promedio'] for r in resultados_repeticiones]
+            esperando = [r['esperando_promedio'] for r in resultados_repeticiones]
+            esperas = [r['espera_media'] for r in resultados_repeticiones]
 
             resultado_config = {
                 'carros': carros,
@@ -507,21 +658,24 @@ if __name__ == "__main__":
                 'throughput_stats': calcular_estadisticas(throughputs),
                 'cpu_stats': calcular_estadisticas(cpus),
                 'memoria_stats': calcular_estadisticas(memorias),
-                'threads_stats': calcular_estadisticas(threads)
+                'threads_stats': calcular_estadisticas(threads),
+                'esperando_stats': calcular_estadisticas(esperando),
+                'esperando_maximo': max(r['esperando_maximo'] for r in resultados_repeticiones),
+                'espera_stats': calcular_estadisticas(esperas)
             }
             
             resultados_finales.append(resultado_config)
 
         # Guardar resultados del programa actual
-        todos_los_resultados[programa_c] = resultados_finales
+        todos_los_resultados[variante] = resultados_finales
         
         # Mostrar resultados individuales del programa
         if resultados_finales:
-            mostrar_tabla_detallada_programa(resultados_finales, programa_c)
-            mostrar_tabla_resumen_programa(resultados_finales, programa_c)
-            print(f"\nBenchmark de {programa_c} completado. Configuraciones probadas: {len(resultados_finales)}")
+            mostrar_tabla_detallada_programa(resultados_finales, variante)
+            mostrar_tabla_resumen_programa(resultados_finales, variante)
+            print(f"\nBenchmark de {variante} completado. Configuraciones probadas: {len(resultados_finales)}")
         else:
-            print(f"\nNo se pudieron obtener resultados para {programa_c}")
+            print(f"\nNo se pudieron obtener resultados para {variante}")
 
     # Mostrar comparación final entre todos los programas
     if todos_los_resultados:
@@ -0,0 +1,20 @@
+// CENTROS DE MANTENIMIENTO DE TESLAS CON COLAS POR ESTACIÓN (Y ROBO DE AUTOS) CON ENTRADA ORDENADA
+//
+// Cada estación tiene su propia cola FIFO de autos esperando y, si su cola está
+// vacía, le roba el primer auto a la estación con la cola más larga
+// (Motor/estrategiaColas.h).
+//
+// El núcleo es el del motor (Motor/mantenimientoDeTeslasMotor.c, ver Motor/programa.h).
+
+#define _XOPEN_SOURCE 600
+#include "../Comun/opciones.h" // Para OPCION_*
+#include "../Motor/programa.h" // Para Programa
+
+#define PROGRAMA_MOTOR
+static const Programa programa = {
+  .estrategia = "colas",
+  .entradaOrdenada = 1,
+  .opciones = OPCIONES_COMUNES | OPCION_POOL,
+};
+
+#include "../Motor/mantenimientoDeTeslasMotor.c"
@@ -0,0 +1,25 @@
+// CENTROS DE MANTENIMIENTO DE TESLAS CON FIBRAS (CORRUTINAS EN ESPACIO DE USUARIO) Y ENTRADA ORDENADA
+//
+// Cada auto es una fibra sin pila y unos pocos hilos del sistema (uno por CPU) las
+// van corriendo (Motor/autosFibra.h). Cada tarea dura 1 segundo con el archivo de 3
+// números. --pool, --lockfree y --simulacion no aplican a esta variante.
+//
+// El núcleo es el del motor (Motor/mantenimientoDeTeslasMotor.c, ver Motor/programa.h).
+
+#define _XOPEN_SOURCE 600
+#include "../Comun/opciones.h" // Para OPCION_*
+#include "../Motor/programa.h" // Para Programa
+
+#define PROGRAMA_MOTOR
+static const Programa programa = {
+  .entradaOrdenada = 1,
+  .duracionNs = 1000000000ull,
+  .opciones = OPCIONES_COMUNES,
+  .fibras = 1,
+  .formatos = {
+    [EVENTO_ESPERA] = "Vehículo %d esperando estación disponible...\n",
+  },
+  .textoFinal = "Todos los vehículos han completado su mantenimiento.\n",
+};
+
+#include "../Motor/mantenimientoDeTeslasMotor.c"
@@ -0,0 +1,122 @@
+import struct
+import sys
+from collections import defaultdict
+
+# Formato de la traza binaria que escriben los programas con --traza (ver Comun/registro.h)
+FIRMA = b"TSLATRZ1"
+EVENTO = struct.Struct("<QiiBB6x")  # tiempoNs, indiceAuto, estacion, tipo, tarea
+EVENTO_16 = struct.Struct("<QihBB")  # Trazas anteriores, con la estación en 16 bits
+
+# Tipos de evento, en el mismo orden que el enum de Comun/registro.h
+EVENTO_INGRESO, EVENTO_ESPERA, EVENTO_INICIO_TAREA, EVENTO_FIN_TAREA, EVENTO_FIN_TODO = range(5)
+
+def leer_textos(datos, posicion):
+    """Lee una lista de textos de la cabecera (cantidad y luego largo + bytes de cada uno)"""
+    (cantidad,) = struct.unpack_from("<I", datos, posicion)
+    posicion += 4
+    textos = []
+    for _ in range(cantidad):
+        (largo,) = struct.unpack_from("<I", datos, posicion)
+        posicion += 4
+        textos.append(datos[posicion:posicion + largo].decode("utf-8"))
+        posicion += largo
+    return textos, posicion
+
+def leer_traza(nombre_archivo):
+    """Lee una traza binaria y retorna (formatos, tareas, eventos) con los eventos ordenados por tiempo"""
+    with open(nombre_archivo, "rb") as archivo:
+        datos = archivo.read()
+    if datos[:8] != FIRMA:
+        raise ValueError(f"{nombre_archivo} no es una traza de mantenimiento de Teslas")
+    (tam_evento,) = struct.unpack_from("<I", datos, 8)
+    formato = {EVENTO.size: EVENTO, EVENTO_16.size: EVENTO_16}.get(tam_evento)
+    if formato is None:
+        raise ValueError(f"Tamaño de evento desconocido: {tam_evento}")
+
+    formatos, posicion = leer_textos(datos, 12)
+    tareas, posicion = leer_textos(datos, posicion)
+
+    # Cada hilo escribe sus eventos en orden, pero los de hilos distintos llegan intercalados
+    cantidad = (len(datos) - posicion) // tam_evento
+    eventos = [formato.unpack_from(datos, posicion + i * tam_evento) for i in range(cantidad)]
+    eventos.sort(key=lambda e: e[0])
+    return formatos, tareas, eventos
+
+def formatear_evento(evento, formatos, tareas):
+    """Arma la misma línea de texto que imprime el programa sin --traza"""
+    _, auto, estacion, tipo, tarea = evento
+    if tipo == EVENTO_INGRESO:
+        return formatos[tipo] % (auto, estacion)
+    if tipo in (EVENTO_INICIO_TAREA, EVENTO_FIN_TAREA):
+        return formatos[tipo] % (auto, tareas[tarea], estacion)
+    return formatos[tipo] % auto
+
+def estadisticas_por_auto(eventos):
+    """Calcula, por auto, la estación, el tiempo de espera y el de servicio (en segundos).
+
+    La traza no tiene un evento de llegada: la espera se mide desde la admisión, es
+    decir desde el primer EVENTO_ESPERA del auto (cuando pidió plaza, ya con su turno
+    si la entrada es ordenada, y no la había) hasta que ingresó. Un auto que encontró
+    plaza enseguida no tiene EVENTO_ESPERA y su espera es 0. El tiempo esperando el
+    turno o en la sala de llegadas no entra.
+    """
+    autos = defaultdict(dict)
+    for tiempo, auto, estacion, tipo, _ in eventos:
+        datos = autos[auto]
+        if tipo == EVENTO_ESPERA:
+            datos.setdefault("admision", tiempo)
+        elif tipo == EVENTO_INGRESO:
+            datos["ingreso"] = tiempo
+            datos["estacion"] = estacion
+        elif tipo == EVENTO_FIN_TODO:
+            datos["salida"] = tiempo
+
+    estadisticas = []
+    for auto in sorted(autos):
+        datos = autos[auto]
+        if "ingreso" not in datos or "salida" not in datos:
+            continue  # La traza se cortó antes de que el auto terminara
+        estadisticas.append({
+            "auto": auto,
+            "estacion": datos["estacion"],
+            "espera_admision": (datos["ingreso"] - datos.get("admision", datos["ingreso"])) / 1e9,
+            "servicio": (datos["salida"] - datos["ingreso"]) / 1e9,
+        })
+    return estadisticas
+
+def resumen_traza(eventos):
+    """Cuenta eventos y autos terminados y calcula el throughput según los tiempos de la traza"""
+    terminados = sum(1 for e in eventos if e[3] == EVENTO_FIN_TODO)
+    duracion = (eventos[-1][0] - eventos[0][0]) / 1e9 if eventos else 0
+    return {
+        "eventos": len(eventos),
+        "autos_terminados": terminados,
+        "duracion": duracion,
+        "eventos_por_segundo": len(eventos) / duracion if duracion > 0 else 0,
+        "autos_por_segundo": terminados / duracion if duracion > 0 else 0,
+    }
+
+def main():
+    if len(sys.argv) < 2 or sys.argv[1] in ("-h", "--help"):
+        print(f"Uso: python3 {sys.argv[0]} traza.bin [--estadisticas]")
+        print("  Sin opciones imprime la traza como el texto original de los programas.")
+        print("  Con --estadisticas imprime un CSV por auto (estación, espera desde la admisión y")
+        print("  servicio) y un resumen.")
+        return 1
+
+    formatos, tareas, eventos = leer_traza(sys.argv[1])
+
+    if "--estadisticas" in sys.argv[2:]:
+        print("auto,estacion,espera_admision_s,servicio_s")
+        for e in estadisticas_por_auto(eventos):
+            print(f"{e['auto']},{e['estacion']},{e['espera_admision']:.6f},{e['servicio']:.6f}")
+        resumen = resumen_traza(eventos)
+        print(f"# {resumen['eventos']} eventos, {resumen['autos_terminados']} autos terminados "
+              f"en {resumen['duracion']:.3f} s ({resumen['autos_por_segundo']:.2f} autos/s)",
+              file=sys.stderr)
+    else:
+        sys.stdout.writelines(formatear_evento(e, formatos, tareas) for e in eventos)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
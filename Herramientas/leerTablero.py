@@ -0,0 +1,109 @@
+import mmap
+import os
+import struct
+import sys
+import time
+
+# Lee en vivo el tablero que publican los programas con --tablero /nombre (ver
+# Comun/tablero.h): contadores atómicos en /dev/shm/nombre, uno por línea de caché.
+# Solo lee: no toma candados ni frena al programa. Cada contador es un entero de 64
+# bits alineado, así que cada lectura ve un valor entero (pero entre un contador y
+# otro el programa puede haber avanzado).
+
+FIRMA = b"TSLTABL1"
+VERSION = 3
+LINEA = 64
+CABECERA = struct.Struct("=8sIiqQq")  # firma, versión, nEstaciones, nAutos, inicioNs, terminado
+CONTADOR = struct.Struct("=q")
+ESTACION = struct.Struct("=qq")  # enServicio, atendidos
+(BLOQUE_LLEGADOS, BLOQUE_ADMITIDOS, BLOQUE_COMPLETADOS, BLOQUE_ESPERA, BLOQUE_RECHAZADOS, BLOQUE_DESCARTADOS,
+ BLOQUE_SALA, BLOQUE_ESTACIONES) = range(1, 9)
+
+def ruta_tablero(nombre):
+    """/teslas -> /dev/shm/teslas"""
+    return os.path.join("/dev/shm", nombre.lstrip("/"))
+
+def abrir_tablero(nombre):
+    """Mapea el tablero (solo lectura). Retorna None si todavía no existe o no está listo."""
+    try:
+        with open(ruta_tablero(nombre), "rb") as archivo:
+            if os.fstat(archivo.fileno()).st_size < LINEA * BLOQUE_ESTACIONES:
+                return None
+            mapa = mmap.mmap(archivo.fileno(), 0, prot=mmap.PROT_READ)
+    except FileNotFoundError:
+        return None
+    firma, version, _, _, _, _ = CABECERA.unpack_from(mapa, 0)
+    if firma != FIRMA or version != VERSION:
+        mapa.close()
+        return None  # El programa todavía no terminó de escribir la cabecera
+    return mapa
+
+def leer_tablero(mapa):
+    """Lee todos los contadores y retorna un diccionario"""
+    _, _, n_estaciones, n_autos, inicio_ns, terminado = CABECERA.unpack_from(mapa, 0)
+    contador = lambda bloque: CONTADOR.unpack_from(mapa, bloque * LINEA)[0]
+    llegados = contador(BLOQUE_LLEGADOS)
+    admitidos = contador(BLOQUE_ADMITIDOS)
+    rechazados = contador(BLOQUE_RECHAZADOS)
+    descartados = contador(BLOQUE_DESCARTADOS)
+    estaciones = [ESTACION.unpack_from(mapa, (BLOQUE_ESTACIONES + i) * LINEA) for i in range(n_estaciones)]
+    return {
+        "autos": n_autos,
+        "inicio_ns": inicio_ns,
+        "terminado": bool(terminado),
+        "llegados": llegados,
+        "admitidos": admitidos,
+        "esperando": max(0, llegados - admitidos - rechazados - descartados),
+        "completados": contador(BLOQUE_COMPLETADOS),
+        "espera_acumulada_s": contador(BLOQUE_ESPERA) / 1e9,
+        "rechazados": rechazados,
+        "descartados": descartados,
+        "en_sala": contador(BLOQUE_SALA),
+        "en_servicio": [e[0] for e in estaciones],
+        "atendidos": [e[1] for e in estaciones],
+    }
+
+def borrar_tablero(nombre):
+    try:
+        os.remove(ruta_tablero(nombre))
+    except FileNotFoundError:
+        pass
+
+def main():
+    argumentos = sys.argv[1:]
+    borrar = "--borrar" in argumentos
+    if borrar:
+        argumentos.remove("--borrar")
+    if not argumentos:
+        print(f"Uso: python3 {sys.argv[0]} /nombre [intervalo_s] [--borrar]")
+        print("  Imprime los contadores del tablero cada intervalo_s (0.5 por defecto) hasta que el")
+        print("  programa termina. Con --borrar, al final borra /dev/shm/nombre.")
+        return 1
+    nombre = argumentos[0]
+    intervalo = float(argumentos[1]) if len(argumentos) > 1 else 0.5
+
+    mapa = abrir_tablero(nombre)
+    while mapa is None:
+        time.sleep(0.05)  # El programa todavía no lo creó
+        mapa = abrir_tablero(nombre)
+    inicio = time.monotonic()
+    while True:
+        datos = leer_tablero(mapa)
+        espera_media = datos["espera_acumulada_s"] / datos["admitidos"] if datos["admitidos"] else 0
+        print(f"{time.monotonic() - inicio:7.2f} s: {datos['completados']}/{datos['autos']} terminados, "
+              f"{datos['esperando']} esperando, en servicio {sum(datos['en_servicio'])} "
+              f"{datos['en_servicio'] if len(datos['en_servicio']) <= 16 else ''}, "
+              f"espera media {espera_media:.6f} s"
+              + (f", {datos['en_sala']} en la sala, {datos['rechazados']} rechazados y "
+                 f"{datos['descartados']} descartados"
+                 if datos["en_sala"] or datos["rechazados"] or datos["descartados"] else ""), flush=True)
+        if datos["terminado"]:
+            break
+        time.sleep(intervalo)
+    mapa.close()
+    if borrar:
+        borrar_tablero(nombre)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
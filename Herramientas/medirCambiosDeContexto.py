@@ -0,0 +1,44 @@
+import os
+import subprocess
+import sys
+import time
+
+# Corre un programa ya compilado varias veces y mide, con wait4(2), los cambios de
+# contexto de todo el proceso (todos sus hilos): voluntarios (el hilo se bloqueó, por
+# ejemplo en un futex) e involuntarios (el planificador le sacó la CPU), y la memoria
+# residente máxima (ru_maxrss). La salida del programa se descarta para que no influya
+# la terminal.
+
+def medir(comando):
+    """Corre el comando una vez y retorna (segundos, voluntarios, involuntarios, cpu_usuario, cpu_sistema, kb_maximos)"""
+    inicio = time.perf_counter()
+    proceso = subprocess.Popen(comando, stdout=subprocess.DEVNULL)
+    _, estado, uso = os.wait4(proceso.pid, 0)
+    duracion = time.perf_counter() - inicio
+    proceso.returncode = os.waitstatus_to_exitcode(estado)
+    if proceso.returncode != 0:
+        raise RuntimeError(f"{' '.join(comando)} terminó con código {proceso.returncode}")
+    return duracion, uso.ru_nvcsw, uso.ru_nivcsw, uso.ru_utime, uso.ru_stime, uso.ru_maxrss
+
+def main():
+    argumentos = sys.argv[1:]
+    repeticiones = 3
+    if "--repeticiones" in argumentos:
+        i = argumentos.index("--repeticiones")
+        repeticiones = int(argumentos[i + 1])
+        del argumentos[i:i + 2]
+    if len(argumentos) < 2:
+        print(f"Uso: python3 {sys.argv[0]} ./programa config.txt [opciones del programa] [--repeticiones N]")
+        print("  Imprime el promedio de tiempo, cambios de contexto y memoria de N corridas (3 por defecto).")
+        return 1
+
+    medidas = [medir(argumentos) for _ in range(repeticiones)]
+    promedio = [sum(m[i] for m in medidas) / repeticiones for i in range(6)]
+    print(f"{' '.join(argumentos)}: {promedio[0]:.3f} s, "
+          f"{promedio[1]:.0f} cambios de contexto voluntarios, {promedio[2]:.0f} involuntarios, "
+          f"CPU {promedio[3]:.3f} s usuario + {promedio[4]:.3f} s sistema, "
+          f"memoria máxima {promedio[5] / 1024:.1f} MB")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,219 @@
+// AUTOS EN FIBRAS (CORRUTINAS EN ESPACIO DE USUARIO) EN LUGAR DE HILOS (--fibras)
+//
+// Cada auto es una fibra sin pila (ver Comun/fibras.h) y unos pocos hilos del sistema
+// (uno por CPU) las van corriendo. Esperar el turno o una plaza bloquea la fibra, no
+// un hilo, y cada tarea es dormir la fibra en la agenda del planificador. Por eso
+// las plazas no pueden ser una Estrategia (todas bloquean al hilo): acá hay un mutex
+// con las plazas libres de cada estación y una fila FIFO, y quien sale le pasa su
+// plaza directo al primero de la fila. Es el núcleo de la variante Fibras.
+//
+// Con entrada ordenada cada auto anota su fibra en la casilla de su turno y el que
+// pide estación antes que él lo despierta al pasarle el turno.
+
+#ifndef AUTOS_FIBRA_H
+#define AUTOS_FIBRA_H
+
+#include <pthread.h>               // Para el mutex de las estaciones
+#include <stdint.h>                // Para uint64_t
+#include <stdlib.h>                // Para calloc, free
+#include <unistd.h>                // Para sysconf (cantidad de CPUs)
+#include "../Comun/escenario.h"    // Para las tareas de cada auto y sus duraciones
+#include "../Comun/registro.h"     // Para registrarEvento y relojNs
+#include "../Comun/politicas.h"    // Para elegir estación con --politica y medir cada estación
+#include "../Comun/latencias.h"    // Para --latencias
+#include "../Comun/prioridades.h"  // Para --prioridades (solo mide)
+#include "../Comun/tablero.h"      // Para --tablero
+#include "../Comun/afinidad.h"     // Para las plazas en la memoria del nodo de su estación
+#include "../Comun/lineaCache.h"   // Para PlazasEstacion (cada estación en su línea de caché)
+#include "../Comun/fibras.h"       // Para las fibras y su planificador
+
+// Cada auto es una fibra; lo que tiene que sobrevivir a una espera va acá
+typedef struct {
+  Fibra fibra;          // Primero, así un Fibra* es también un AutoFibra*
+  int indiceAuto;
+  int estacionAsignada; // La pone el auto o quien le pasa la plaza
+  int tarea;            // Tarea en curso (índice en el escenario)
+  uint64_t llegadaNs;   // Para medir la espera y la ocupación (--politica)
+  uint64_t ingresoNs;
+  uint64_t marcaNs;     // Inicio de la fase en curso (--latencias)
+} AutoFibra;
+
+static struct {
+  const Escenario* escenario;
+  int politica, entradaOrdenada;
+  AutoFibra* autos;               // Un struct chico por auto, sin pila propia
+  pthread_mutex_t mutex;          // Protege las plazas, la fila de espera y el turno
+  PlazasEstacion* plazas;         // Plazas libres de cada estación
+  Fibra *primeroEnFila, *ultimoEnFila; // Fila FIFO (enlazada por fibra.siguiente)
+  int turnoAuto;                  // Turno actual con entrada ordenada (comienza en 1)
+  Fibra** esperandoTurno;         // Fibra que espera cada turno (NULL si todavía no llegó)
+} enFibras = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+
+// Anota al auto para su turno; devuelve 1 si tiene que esperarlo
+static int autosFibraEsperarTurno(AutoFibra* a) {
+  pthread_mutex_lock(&enFibras.mutex);
+  int tieneQueEsperar = a->indiceAuto != enFibras.turnoAuto;
+  if (tieneQueEsperar) {
+    // Lo despierta el auto anterior cuando le pase el turno
+    enFibras.esperandoTurno[a->indiceAuto] = &a->fibra;
+  }
+  pthread_mutex_unlock(&enFibras.mutex);
+  return tieneQueEsperar;
+}
+
+// Toma una plaza o se pone en la fila (y pasa el turno); devuelve 1 si quedó en la fila
+static int autosFibraPedirEstacion(AutoFibra* a) {
+  pthread_mutex_lock(&enFibras.mutex);
+  // Elijo estación según la política (--politica; por defecto la primera con plaza)
+  a->estacionAsignada = politicaTomar(enFibras.politica, enFibras.escenario->nEstaciones,
+                                      politicaLibresEnPlazas, politicaOcuparEnPlazas, enFibras.plazas);
+  int enFila = a->estacionAsignada < 0;
+  if (enFila) {
+    // No había lugar: queda en la fila hasta que alguien le pase su plaza
+    registrarEvento(EVENTO_ESPERA, a->indiceAuto, 0, 0);
+    a->fibra.siguiente = NULL;
+    if (enFibras.ultimoEnFila) {
+      enFibras.ultimoEnFila->siguiente = &a->fibra;
+    } else {
+      enFibras.primeroEnFila = &a->fibra;
+    }
+    enFibras.ultimoEnFila = &a->fibra;
+  }
+
+  // Pasa el turno al siguiente auto; si ya lo estaba esperando, lo despierta
+  Fibra* siguiente = NULL;
+  if (enFibras.entradaOrdenada) {
+    siguiente = enFibras.esperandoTurno[++enFibras.turnoAuto];
+  }
+  pthread_mutex_unlock(&enFibras.mutex);
+  if (siguiente) {
+    fibrasDespertar(siguiente);
+  }
+  return enFila;
+}
+
+// Le pasa la plaza al primero de la fila o la devuelve
+static void autosFibraLiberarEstacion(int estacion) {
+  pthread_mutex_lock(&enFibras.mutex);
+  Fibra* primero = enFibras.primeroEnFila;
+  if (primero) {
+    // La plaza pasa directo al primero de la fila, sin devolverla
+    enFibras.primeroEnFila = primero->siguiente;
+    if (!enFibras.primeroEnFila) {
+      enFibras.ultimoEnFila = NULL;
+    }
+    ((AutoFibra*)primero)->estacionAsignada = estacion;
+  } else {
+    enFibras.plazas[estacion - 1].plazasLibres++;
+  }
+  pthread_mutex_unlock(&enFibras.mutex);
+  if (primero) {
+    fibrasDespertar(primero);
+  }
+}
+
+/* ---------------------------------------------------------
+Cada auto (fibra) ejecuta esta rutina, que se retoma donde
+quedó cada vez que el planificador la vuelve a correr:
+1) Con entrada ordenada, espera su turno (bloqueando solo la fibra).
+2) Toma una plaza o espera en la fila hasta que se la pasen.
+3) Realiza las tareas de su perfil (dormir lo que dura cada una).
+4) Libera la plaza para el primero de la fila.
+------------------------------------------------------------*/
+static int autosFibraRutina(Fibra* fibra) {
+  AutoFibra* a = (AutoFibra*)fibra;
+  const Escenario* escenario = enFibras.escenario;
+  FIBRA_INICIO(fibra);
+  a->llegadaNs = relojNs();
+  a->marcaNs = a->llegadaNs;
+  tableroLlegada();
+
+  // 1) ESPERAR SU TURNO ORDENADO
+  // ---------------------------------------------------
+  if (enFibras.entradaOrdenada) {
+    FIBRA_ESPERAR_SI(fibra, autosFibraEsperarTurno(a));
+    latenciasMarcar(FASE_TURNO, &a->marcaNs);
+  }
+
+  // 2) TRATAR DE ENTRAR A ALGUNA ESTACIÓN
+  // ---------------------------------------------------
+  FIBRA_ESPERAR_SI(fibra, autosFibraPedirEstacion(a));
+  registrarEvento(EVENTO_INGRESO, a->indiceAuto, a->estacionAsignada, 0);
+  a->ingresoNs = relojNs();
+  metricasIngreso(a->estacionAsignada, a->ingresoNs - a->llegadaNs);
+  latenciasMarcar(FASE_ESTACION, &a->marcaNs);
+  tableroIngreso(a->estacionAsignada, a->ingresoNs - a->llegadaNs);
+  prioridadesIngreso(a->indiceAuto, a->ingresoNs - a->llegadaNs);
+
+  // 3) HACER LAS TAREAS DE MANTENIMIENTO (LAS DE SU PERFIL)
+  // ---------------------------------------------------
+  for (a->tarea = 0; a->tarea < escenario->nTareas; a->tarea++) {
+    if (!escenarioHaceTarea(escenario, a->indiceAuto, a->tarea)) {
+      continue; // Su perfil no incluye esta tarea
+    }
+    // Simulo el trabajo sin ocupar el hilo
+    FIBRA_DORMIR(fibra, escenarioDuracionNs(escenario, a->indiceAuto, a->tarea));
+    registrarEvento(EVENTO_INICIO_TAREA, a->indiceAuto, a->estacionAsignada, a->tarea);
+    registrarEvento(EVENTO_FIN_TAREA, a->indiceAuto, a->estacionAsignada, a->tarea);
+    latenciasMarcar(FASE_PRIMERA_TAREA + a->tarea, &a->marcaNs);
+  }
+
+  // 4) TERMINÓ TODO, LIBERAR PLAZA
+  // ---------------------------------------------------
+  registrarEvento(EVENTO_FIN_TODO, a->indiceAuto, a->estacionAsignada, 0);
+  metricasSalida(a->estacionAsignada, relojNs() - a->ingresoNs);
+  tableroSalida(a->estacionAsignada);
+  prioridadesSalida(a->indiceAuto, a->llegadaNs);
+  autosFibraLiberarEstacion(a->estacionAsignada);
+  latenciasMarcar(FASE_SALIDA, &a->marcaNs);
+
+  FIBRA_FIN(fibra);
+}
+
+/* ---------------------------------------------------------
+Corre todos los autos del escenario como fibras, con un hilo
+del sistema por CPU. Devuelve los segundos que tardó o -1 si
+no hay memoria o no se pudieron crear los hilos.
+------------------------------------------------------------*/
+static double autosFibraCorrer(const Escenario* escenario, int politica, int entradaOrdenada) {
+  int nAutos = escenario->nAutos, nEstaciones = escenario->nEstaciones;
+  enFibras.escenario = escenario;
+  enFibras.politica = politica;
+  enFibras.entradaOrdenada = entradaOrdenada;
+  enFibras.turnoAuto = 1;
+  enFibras.primeroEnFila = enFibras.ultimoEnFila = NULL;
+  enFibras.plazas = afinidadReservar(nEstaciones, sizeof(PlazasEstacion));
+  // Una casilla por turno (más una para el que sigue al último)
+  enFibras.esperandoTurno = calloc(nAutos + 2, sizeof(Fibra*));
+  enFibras.autos = calloc(nAutos > 0 ? nAutos : 1, sizeof(AutoFibra));
+  if (!enFibras.plazas || !enFibras.esperandoTurno || !enFibras.autos) {
+    return -1;
+  }
+  for (int i = 0; i < nEstaciones; i++) {
+    enFibras.plazas[i].plazasLibres = escenario->capacidades[i];
+  }
+
+  fibrasIniciar();
+  for (int i = 0; i < nAutos; i++) {
+    enFibras.autos[i].fibra.rutina = autosFibraRutina;
+    enFibras.autos[i].indiceAuto = i + 1;
+    enFibras.autos[i].estacionAsignada = -1;
+    fibrasDespertar(&enFibras.autos[i].fibra);
+  }
+
+  // Un hilo del sistema por CPU, sin importar cuántos autos haya
+  int nHilos = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (nHilos < 1) {
+    nHilos = 1;
+  }
+  uint64_t inicioNs = relojNs();
+  int error = fibrasCorrer(nHilos, nAutos);
+  double duracion = (relojNs() - inicioNs) / 1e9;
+
+  afinidadLiberar(enFibras.plazas, nEstaciones, sizeof(PlazasEstacion));
+  free(enFibras.esperandoTurno);
+  free(enFibras.autos);
+  return error ? -1 : duracion;
+}
+
+#endif
@@ -0,0 +1,44 @@
+// INTERFAZ DE LAS ESTRATEGIAS DE SINCRONIZACIÓN DEL MOTOR
+//
+// Los programas de "Entrada Ordenada" y "Entrada Desordenada" tienen el mismo núcleo
+// (leer el escenario, crear los hilos, hacer las tareas, registrar los eventos) y
+// solo cambia cómo un auto consigue una plaza y cómo la devuelve. El motor
+// (mantenimientoDeTeslasMotor.c) tiene ese núcleo una sola vez y la parte que
+// cambia es una Estrategia, elegida con --estrategia o por el programa que lo
+// incluye (ver programa.h).
+//
+// Para agregar una estrategia nueva: un archivo estrategiaX.h que defina un
+// "static const Estrategia estrategiaX" (con inicializadores designados, .nombre = ...,
+// para que un campo nuevo no desacomode a los demás) y una línea en la tabla del motor.
+
+#ifndef ESTRATEGIA_H
+#define ESTRATEGIA_H
+
+#include "../Comun/escenario.h" // Para Escenario (capacidad de cada estación)
+
+typedef struct {
+  const char* nombre;      // Lo que se escribe después de --estrategia
+  const char* descripcion; // Para la ayuda y el resumen
+
+  // Prepara las plazas de las estaciones (capacidades del escenario) y lo que
+  // necesite para que esperen hasta "nAutos" autos. "politica" es POLITICA_* para
+  // elegir estación. Devuelve -1 si no hay memoria.
+  int (*iniciar)(const Escenario* escenario, int nAutos, int politica);
+
+  // Bloquea al auto hasta que tenga una plaza y devuelve su estación (1..n). Si
+  // tiene que esperar registra EVENTO_ESPERA (una vez por cada vez que se duerme).
+  int (*entrar)(int indiceAuto);
+
+  // El auto sale de "estacion" (1..n): devuelve la plaza o se la pasa a otro
+  void (*salir)(int estacion);
+
+  void (*destruir)(void);
+
+  // 1 si los hilos esperan en una barrera a que terminen todos (variante Barrera)
+  int barreraAlFinal;
+
+  // Imprime lo que la estrategia midió en la corrida (NULL si no mide nada)
+  void (*resumen)(void);
+} Estrategia;
+
+#endif
@@ -0,0 +1,60 @@
+// ESTRATEGIA "atomica": PLAZAS LOCK-FREE Y ESPERA ADAPTATIVA
+//
+// Las plazas son los contadores atómicos de Comun/estacionesAtomicas.h (la que usan
+// los programas con --lockfree): entrar y salir no toman ningún candado. Quien no
+// encuentra lugar gira un poco y después duerme en el aviso de plaza liberada.
+
+#ifndef ESTRATEGIA_ATOMICA_H
+#define ESTRATEGIA_ATOMICA_H
+
+#include "estrategia.h"
+#include "../Comun/esperaAdaptativa.h"   // Para el aviso de plaza liberada
+#include "../Comun/estacionesAtomicas.h" // Para las plazas con CAS
+#include "../Comun/registro.h"           // Para registrarEvento
+
+static struct {
+  EstacionesAtomicas estaciones;
+  int politica;
+  Aviso plazaLiberada;
+} atomica;
+
+static int atomicaIniciar(const Escenario* escenario, int nAutos, int politica) {
+  (void)nAutos;
+  atomica.politica = politica;
+  atomica.plazaLiberada = (Aviso)AVISO_INICIAL;
+  return estacionesAtomicasIniciar(&atomica.estaciones, escenario->nEstaciones, escenario->capacidades);
+}
+
+static int atomicaEntrar(int indiceAuto) {
+  while (1) {
+    int ticket = avisoTicket(&atomica.plazaLiberada);
+    int estacion = estacionesAtomicasTomar(&atomica.estaciones, atomica.politica);
+    if (estacion > 0) {
+      return estacion;
+    }
+    registrarEvento(EVENTO_ESPERA, indiceAuto, 0, 0);
+    avisoEsperar(&atomica.plazaLiberada, ticket);
+  }
+}
+
+static void atomicaSalir(int estacion) {
+  estacionesAtomicasLiberar(&atomica.estaciones, estacion);
+  avisoDespertarUno(&atomica.plazaLiberada);
+}
+
+static void atomicaDestruir(void) {
+  estacionesAtomicasDestruir(&atomica.estaciones);
+}
+
+static const Estrategia estrategiaAtomica = {
+  .nombre = "atomica",
+  .descripcion = "contadores atómicos por estación (CAS, sin candados) y espera adaptativa",
+  .iniciar = atomicaIniciar,
+  .entrar = atomicaEntrar,
+  .salir = atomicaSalir,
+  .destruir = atomicaDestruir,
+  .barreraAlFinal = 0,
+  .resumen = NULL,
+};
+
+#endif
@@ -0,0 +1,244 @@
+// ESTRATEGIA "colas": UNA COLA DE ESPERA POR ESTACIÓN CON ROBO DE AUTOS
+//
+// La de mantenimientoDeTeslasColas.c: cada estación tiene su candado, sus plazas y
+// su cola FIFO de autos esperando (cada uno en su propio semáforo). Quien sale le
+// pasa la plaza al primero de la cola de su estación; si la cola está vacía, le
+// roba el primer auto a la estación con la cola más larga. Con --prioridades cada
+// cola tiene una sub-fila por clase (ver Comun/prioridades.h).
+//
+// Las plazas libres de cada estación se leen sin candado y dos marcas por estación
+// (ver Comun/marcasEstaciones.h) dicen cuáles tienen plaza y cuáles tienen cola: ni el
+// auto que se encola ni el que roba recorren las nEstaciones.
+
+#ifndef ESTRATEGIA_COLAS_H
+#define ESTRATEGIA_COLAS_H
+
+#include <pthread.h>   // Para el candado de cada estación
+#include <semaphore.h> // Para el semáforo propio de cada auto en espera
+#include <stdatomic.h> // Para las plazas libres y el largo de las colas
+#include "estrategia.h"
+#include "../Comun/afinidad.h"  // Para afinidadReservar (cada estación en la memoria de su nodo)
+#include "../Comun/marcasEstaciones.h" // Para encontrar estaciones con plaza o con cola sin recorrerlas
+#include "../Comun/politicas.h" // Para politicaTomar y politicaElegir
+#include "../Comun/prioridades.h" // Para la cola con una sub-fila por clase
+#include "../Comun/registro.h"  // Para registrarEvento
+
+// Un auto que no encontró plaza. Vive en la pila de su propio hilo mientras espera.
+typedef struct AutoEnCola {
+  EnFila enFila;                // Lugar en la cola de la estación (primer campo)
+  int estacionAsignada;         // La pone quien le pasa la plaza
+  sem_t listo;                  // Semáforo propio del auto: nadie más espera en él
+} AutoEnCola;
+
+// Cada estación en su propia línea de caché (ver Comun/lineaCache.h)
+typedef struct {
+  _Alignas(LINEA_CACHE) pthread_mutex_t candado; // Protege los cambios de plazasLibres y la cola
+  atomic_int plazasLibres; // Se lee sin candado (y se vuelve a mirar con él antes de tomar)
+  FilaPrioridades fila;    // Cola FIFO de autos esperando (una por clase con --prioridades)
+  atomic_int largoCola;    // Se lee sin candado para elegir a quién robarle
+} EstacionConCola;
+
+static struct {
+  EstacionConCola* estaciones;
+  int nEstaciones;
+  int nAutos;
+  int politica;
+  atomic_int autosEsperando; // Total en todas las colas (se cambia con el candado de la cola)
+  MarcasEstaciones conPlaza; // Estaciones con plazasLibres > 0
+  MarcasEstaciones conCola;  // Estaciones con largoCola > 0
+} colas;
+
+// Ocupa una plaza de la estación (1..n) si tiene alguna libre; 1 si la tomó. Si se
+// ve llena sin candado no lo toma.
+static int colasTomarPlaza(int estacion) {
+  EstacionConCola* e = &colas.estaciones[estacion - 1];
+  if (atomic_load_explicit(&e->plazasLibres, memory_order_relaxed) == 0) {
+    return 0;
+  }
+  int tomada = 0;
+  pthread_mutex_lock(&e->candado);
+  int libres = atomic_load_explicit(&e->plazasLibres, memory_order_relaxed);
+  if (libres > 0) {
+    atomic_store_explicit(&e->plazasLibres, libres - 1, memory_order_relaxed);
+    if (libres == 1) {
+      marcasSacar(&colas.conPlaza, estacion - 1);
+    }
+    tomada = 1;
+  }
+  pthread_mutex_unlock(&e->candado);
+  return tomada;
+}
+
+static void colasDevolverPlaza(int estacion) {
+  EstacionConCola* e = &colas.estaciones[estacion - 1];
+  pthread_mutex_lock(&e->candado);
+  if (atomic_fetch_add_explicit(&e->plazasLibres, 1, memory_order_relaxed) == 0) {
+    marcasPoner(&colas.conPlaza, estacion - 1);
+  }
+  pthread_mutex_unlock(&e->candado);
+}
+
+// La marca de la cola se pone antes de sumar a autosEsperando y se saca después de
+// restar: quien ve autosEsperando > 0 encuentra alguna cola marcada
+static void colasEncolar(int estacion, AutoEnCola* a, int indiceAuto) {
+  EstacionConCola* e = &colas.estaciones[estacion - 1];
+  pthread_mutex_lock(&e->candado);
+  filaPrioridadesPoner(&e->fila, &a->enFila, indiceAuto);
+  if (atomic_fetch_add(&e->largoCola, 1) == 0) {
+    marcasPoner(&colas.conCola, estacion - 1);
+  }
+  atomic_fetch_add(&colas.autosEsperando, 1);
+  pthread_mutex_unlock(&e->candado);
+}
+
+// Saca al primer auto de la cola de la estación (NULL si está vacía)
+static AutoEnCola* colasDesencolar(int estacion) {
+  EstacionConCola* e = &colas.estaciones[estacion - 1];
+  pthread_mutex_lock(&e->candado);
+  AutoEnCola* primero = (AutoEnCola*)filaPrioridadesSacar(&e->fila);
+  if (primero) {
+    atomic_fetch_sub(&colas.autosEsperando, 1);
+    if (atomic_fetch_sub(&e->largoCola, 1) == 1) {
+      marcasSacar(&colas.conCola, estacion - 1);
+    }
+  }
+  pthread_mutex_unlock(&e->candado);
+  return primero;
+}
+
+// Saca un auto de la cola más larga entre las marcadas (el largo se mira sin candado:
+// NULL si otro se adelantó o no había nadie, y quien llama vuelve a mirar autosEsperando)
+static AutoEnCola* colasRobar(void) {
+  int masLarga = 0, largoMaximo = 0;
+  for (int i = marcasSiguiente(&colas.conCola, 0); i >= 0; i = marcasSiguiente(&colas.conCola, i + 1)) {
+    int largo = atomic_load_explicit(&colas.estaciones[i].largoCola, memory_order_relaxed);
+    if (largo > largoMaximo) {
+      largoMaximo = largo;
+      masLarga = i + 1;
+    }
+  }
+  return masLarga ? colasDesencolar(masLarga) : NULL;
+}
+
+static void colasEntregar(int estacion, AutoEnCola* a) {
+  a->estacionAsignada = estacion;
+  sem_post(&a->listo);
+}
+
+// Mientras la estación tenga plazas libres y haya autos en alguna cola, se las reparte
+static void colasRepartir(int estacion) {
+  while (atomic_load(&colas.autosEsperando) > 0) {
+    if (!colasTomarPlaza(estacion)) {
+      return;
+    }
+    AutoEnCola* robado = colasRobar();
+    if (!robado) {
+      colasDevolverPlaza(estacion); // Ya no quedaba nadie (u otro se lo llevó)
+      continue;
+    }
+    colasEntregar(estacion, robado);
+  }
+}
+
+static int colasLibresEn(void* e, int i) {
+  return atomic_load_explicit(&((EstacionConCola*)e)[i].plazasLibres, memory_order_relaxed);
+}
+
+// Con la política primera (y sin preferir el nodo): la primera estación marcada con plaza
+static int colasTomarPrimera(void) {
+  for (int i = marcasSiguiente(&colas.conPlaza, 0); i >= 0; i = marcasSiguiente(&colas.conPlaza, i + 1)) {
+    if (colasTomarPlaza(i + 1)) {
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+static int colasOcuparEn(void* e, int i) {
+  (void)e;
+  return colasTomarPlaza(i + 1);
+}
+
+// Puntaje de la cola i para la política: más alto cuanto más corta es
+static int colasLugaresAdelante(void* e, int i) {
+  return colas.nAutos + 1 - atomic_load_explicit(&((EstacionConCola*)e)[i].largoCola, memory_order_relaxed);
+}
+
+static int colasIniciar(const Escenario* escenario, int nAutos, int politica) {
+  colas.nEstaciones = escenario->nEstaciones;
+  colas.nAutos = nAutos;
+  colas.politica = politica;
+  atomic_init(&colas.autosEsperando, 0);
+  colas.estaciones = afinidadReservar(escenario->nEstaciones, sizeof(EstacionConCola));
+  if (!colas.estaciones || marcasIniciar(&colas.conPlaza, colas.nEstaciones) != 0 ||
+      marcasIniciar(&colas.conCola, colas.nEstaciones) != 0) {
+    return -1;
+  }
+  for (int i = 0; i < escenario->nEstaciones; i++) {
+    pthread_mutex_init(&colas.estaciones[i].candado, NULL);
+    atomic_init(&colas.estaciones[i].plazasLibres, escenario->capacidades[i]);
+    if (escenario->capacidades[i] > 0) {
+      marcasPoner(&colas.conPlaza, i);
+    }
+    filaPrioridadesIniciar(&colas.estaciones[i].fila);
+    atomic_init(&colas.estaciones[i].largoCola, 0);
+  }
+  return 0;
+}
+
+static int colasEntrar(int indiceAuto) {
+  int estacion = colas.politica == POLITICA_PRIMERA && !afinidadPreferirNodo()
+                     ? colasTomarPrimera()
+                     : politicaTomar(colas.politica, colas.nEstaciones, colasLibresEn, colasOcuparEn,
+                                     colas.estaciones);
+  if (estacion > 0) {
+    return estacion;
+  }
+  // Sin plaza: espera en la cola de su estación por número (o la que elija la política)
+  AutoEnCola yo;
+  sem_init(&yo.listo, 0, 0);
+  int cola = colas.politica == POLITICA_PRIMERA
+                 ? (indiceAuto - 1) % colas.nEstaciones + 1
+                 : politicaElegir(colas.politica, colas.nEstaciones, colasLugaresAdelante, colas.estaciones) + 1;
+  colasEncolar(cola, &yo, indiceAuto);
+  registrarEvento(EVENTO_ESPERA, indiceAuto, 0, 0);
+  // Una plaza pudo liberarse mientras se encolaba: se revisan las estaciones marcadas
+  for (int i = marcasSiguiente(&colas.conPlaza, 0); i >= 0; i = marcasSiguiente(&colas.conPlaza, i + 1)) {
+    colasRepartir(i + 1);
+  }
+  sem_wait(&yo.listo);
+  sem_destroy(&yo.listo);
+  return yo.estacionAsignada;
+}
+
+static void colasSalir(int estacion) {
+  AutoEnCola* siguiente = colasDesencolar(estacion);
+  if (siguiente) {
+    colasEntregar(estacion, siguiente);
+    return;
+  }
+  colasDevolverPlaza(estacion);
+  colasRepartir(estacion);
+}
+
+static void colasDestruir(void) {
+  for (int i = 0; i < colas.nEstaciones; i++) {
+    pthread_mutex_destroy(&colas.estaciones[i].candado);
+  }
+  afinidadLiberar(colas.estaciones, colas.nEstaciones, sizeof(EstacionConCola));
+  marcasDestruir(&colas.conPlaza);
+  marcasDestruir(&colas.conCola);
+}
+
+static const Estrategia estrategiaColas = {
+  .nombre = "colas",
+  .descripcion = "una cola FIFO por estación con traspaso de plaza y robo de autos",
+  .iniciar = colasIniciar,
+  .entrar = colasEntrar,
+  .salir = colasSalir,
+  .destruir = colasDestruir,
+  .barreraAlFinal = 0,
+  .resumen = NULL,
+};
+
+#endif
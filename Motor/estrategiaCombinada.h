@@ -0,0 +1,85 @@
+// ESTRATEGIA "combinada": ENTRADAS Y SALIDAS ATENDIDAS POR LOTES (FLAT COMBINING)
+//
+// La de mantenimientoDeTeslasCondicion.c --combinar: las plazas libres se cuentan en
+// un array, pero nadie espera en un mutex. Cada auto deja su pedido en la pila de
+// Comun/combinador.h y el que consigue el candado atiende todos los pendientes de una
+// vez. Al final de cada corrida imprime cuántos pedidos se atendieron por toma.
+
+#ifndef ESTRATEGIA_COMBINADA_H
+#define ESTRATEGIA_COMBINADA_H
+
+#include "estrategia.h"
+#include "../Comun/afinidad.h"   // Para afinidadReservar (cada estación en la memoria de su nodo)
+#include "../Comun/combinador.h" // Para la pila de pedidos y el combinador
+#include "../Comun/politicas.h"  // Para politicaTomar
+#include "../Comun/registro.h"   // Para registrarEvento
+
+static struct {
+  PlazasEstacion* plazas; // plazas[i].plazasLibres = plazas libres de la estación i+1 (con el candado)
+  int nEstaciones;
+  int politica;
+  Combinador combinador;
+} combinada;
+
+// salir() no recibe el auto: es el último que entró desde este hilo (un auto entra y
+// sale siempre desde el mismo hilo, también con --pool)
+static _Thread_local int autoCombinadoDelHilo;
+
+static int combinadaTomar(void) {
+  return politicaTomar(combinada.politica, combinada.nEstaciones, politicaLibresEnPlazas, politicaOcuparEnPlazas,
+                       combinada.plazas);
+}
+
+static void combinadaLiberar(int estacion) {
+  combinada.plazas[estacion - 1].plazasLibres++;
+}
+
+static int combinadaIniciar(const Escenario* escenario, int nAutos, int politica) {
+  combinada.nEstaciones = escenario->nEstaciones;
+  combinada.politica = politica;
+  combinada.plazas = afinidadReservar(escenario->nEstaciones, sizeof(PlazasEstacion));
+  if (!combinada.plazas || combinadorIniciar(&combinada.combinador, nAutos, combinadaTomar, combinadaLiberar) != 0) {
+    afinidadLiberar(combinada.plazas, escenario->nEstaciones, sizeof(PlazasEstacion));
+    return -1;
+  }
+  for (int i = 0; i < escenario->nEstaciones; i++) {
+    combinada.plazas[i].plazasLibres = escenario->capacidades[i];
+  }
+  return 0;
+}
+
+static int combinadaEntrar(int indiceAuto) {
+  autoCombinadoDelHilo = indiceAuto;
+  int estacion = combinadorPedirEntrada(&combinada.combinador, indiceAuto);
+  if (estacion < 0) {
+    registrarEvento(EVENTO_ESPERA, indiceAuto, 0, 0);
+    estacion = combinadorEsperarEntrada(&combinada.combinador, indiceAuto);
+  }
+  return estacion;
+}
+
+static void combinadaSalir(int estacion) {
+  combinadorSalir(&combinada.combinador, autoCombinadoDelHilo, estacion);
+}
+
+static void combinadaDestruir(void) {
+  afinidadLiberar(combinada.plazas, combinada.nEstaciones, sizeof(PlazasEstacion));
+  combinadorDestruir(&combinada.combinador);
+}
+
+static void combinadaResumen(void) {
+  combinadorImprimir(&combinada.combinador);
+}
+
+static const Estrategia estrategiaCombinada = {
+  .nombre = "combinada",
+  .descripcion = "pedidos de entrar y salir atendidos por lotes con una sola toma del candado",
+  .iniciar = combinadaIniciar,
+  .entrar = combinadaEntrar,
+  .salir = combinadaSalir,
+  .destruir = combinadaDestruir,
+  .barreraAlFinal = 0,
+  .resumen = combinadaResumen,
+};
+
+#endif
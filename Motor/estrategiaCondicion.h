@@ -0,0 +1,78 @@
+// ESTRATEGIA "condicion": MUTEX GLOBAL Y VARIABLE DE CONDICIÓN
+//
+// La de mantenimientoDeTeslasCondicion.c: las plazas libres se cuentan en un array
+// bajo un mutex y quien no encuentra lugar duerme en una condicional. Cada plaza
+// liberada despierta a un solo auto (y solo si hay alguno esperando).
+
+#ifndef ESTRATEGIA_CONDICION_H
+#define ESTRATEGIA_CONDICION_H
+
+#include <pthread.h> // Para el mutex y la condicional
+#include "estrategia.h"
+#include "../Comun/afinidad.h"  // Para afinidadReservar (cada estación en la memoria de su nodo)
+#include "../Comun/politicas.h" // Para politicaTomar
+#include "../Comun/registro.h"  // Para registrarEvento
+
+static struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t hayPlaza;
+  PlazasEstacion* plazas; // plazas[i].plazasLibres = plazas libres de la estación i+1 (con el mutex), una por línea
+  int nEstaciones;
+  int politica;
+  int autosEsperando; // Autos dormidos en hayPlaza (con el mutex)
+} condicion = {.mutex = PTHREAD_MUTEX_INITIALIZER, .hayPlaza = PTHREAD_COND_INITIALIZER};
+
+static int condicionIniciar(const Escenario* escenario, int nAutos, int politica) {
+  (void)nAutos;
+  condicion.nEstaciones = escenario->nEstaciones;
+  condicion.politica = politica;
+  condicion.autosEsperando = 0;
+  condicion.plazas = afinidadReservar(escenario->nEstaciones, sizeof(PlazasEstacion));
+  if (!condicion.plazas) {
+    return -1;
+  }
+  for (int i = 0; i < escenario->nEstaciones; i++) {
+    condicion.plazas[i].plazasLibres = escenario->capacidades[i];
+  }
+  return 0;
+}
+
+static int condicionEntrar(int indiceAuto) {
+  int estacion;
+  pthread_mutex_lock(&condicion.mutex);
+  while ((estacion = politicaTomar(condicion.politica, condicion.nEstaciones, politicaLibresEnPlazas,
+                                   politicaOcuparEnPlazas, condicion.plazas)) < 0) {
+    registrarEvento(EVENTO_ESPERA, indiceAuto, 0, 0);
+    condicion.autosEsperando++;
+    pthread_cond_wait(&condicion.hayPlaza, &condicion.mutex);
+    condicion.autosEsperando--;
+  }
+  pthread_mutex_unlock(&condicion.mutex);
+  return estacion;
+}
+
+static void condicionSalir(int estacion) {
+  pthread_mutex_lock(&condicion.mutex);
+  condicion.plazas[estacion - 1].plazasLibres++;
+  if (condicion.autosEsperando > 0) {
+    pthread_cond_signal(&condicion.hayPlaza);
+  }
+  pthread_mutex_unlock(&condicion.mutex);
+}
+
+static void condicionDestruir(void) {
+  afinidadLiberar(condicion.plazas, condicion.nEstaciones, sizeof(PlazasEstacion));
+}
+
+static const Estrategia estrategiaCondicion = {
+  .nombre = "condicion",
+  .descripcion = "mutex global y variable de condición (un despertar por plaza)",
+  .iniciar = condicionIniciar,
+  .entrar = condicionEntrar,
+  .salir = condicionSalir,
+  .destruir = condicionDestruir,
+  .barreraAlFinal = 0,
+  .resumen = NULL,
+};
+
+#endif
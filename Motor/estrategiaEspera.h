@@ -0,0 +1,91 @@
+// ESTRATEGIAS "espera" Y "barrera": MUTEX GLOBAL Y ESPERA ADAPTATIVA
+//
+// Las de mantenimientoDeTeslasEspera.c y mantenimientoDeTeslasBarrera.c: las plazas
+// libres se cuentan en un array bajo un mutex y quien no encuentra lugar gira un
+// poco y después duerme en el aviso de plaza liberada (Comun/esperaAdaptativa.h).
+// "barrera" es lo mismo pero cada hilo espera al final en una barrera a que
+// terminen todos, como en la variante Barrera.
+
+#ifndef ESTRATEGIA_ESPERA_H
+#define ESTRATEGIA_ESPERA_H
+
+#include <pthread.h> // Para el mutex
+#include "estrategia.h"
+#include "../Comun/afinidad.h"         // Para afinidadReservar (cada estación en la memoria de su nodo)
+#include "../Comun/esperaAdaptativa.h" // Para el aviso de plaza liberada
+#include "../Comun/politicas.h"        // Para politicaTomar
+#include "../Comun/registro.h"         // Para registrarEvento
+
+static struct {
+  pthread_mutex_t mutex;
+  PlazasEstacion* plazas; // plazas[i].plazasLibres = plazas libres de la estación i+1 (con el mutex), una por línea
+  int nEstaciones;
+  int politica;
+  Aviso plazaLiberada;
+} espera = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+
+static int esperaIniciar(const Escenario* escenario, int nAutos, int politica) {
+  (void)nAutos;
+  espera.nEstaciones = escenario->nEstaciones;
+  espera.politica = politica;
+  espera.plazaLiberada = (Aviso)AVISO_INICIAL;
+  espera.plazas = afinidadReservar(escenario->nEstaciones, sizeof(PlazasEstacion));
+  if (!espera.plazas) {
+    return -1;
+  }
+  for (int i = 0; i < escenario->nEstaciones; i++) {
+    espera.plazas[i].plazasLibres = escenario->capacidades[i];
+  }
+  return 0;
+}
+
+static int esperaEntrar(int indiceAuto) {
+  while (1) {
+    // Ticket antes de probar: si liberan una plaza después, avisoEsperar no se duerme
+    int ticket = avisoTicket(&espera.plazaLiberada);
+    pthread_mutex_lock(&espera.mutex);
+    int estacion = politicaTomar(espera.politica, espera.nEstaciones, politicaLibresEnPlazas,
+                                 politicaOcuparEnPlazas, espera.plazas);
+    pthread_mutex_unlock(&espera.mutex);
+    if (estacion > 0) {
+      return estacion;
+    }
+    registrarEvento(EVENTO_ESPERA, indiceAuto, 0, 0);
+    avisoEsperar(&espera.plazaLiberada, ticket);
+  }
+}
+
+static void esperaSalir(int estacion) {
+  pthread_mutex_lock(&espera.mutex);
+  espera.plazas[estacion - 1].plazasLibres++;
+  pthread_mutex_unlock(&espera.mutex);
+  avisoDespertarUno(&espera.plazaLiberada);
+}
+
+static void esperaDestruir(void) {
+  afinidadLiberar(espera.plazas, espera.nEstaciones, sizeof(PlazasEstacion));
+}
+
+static const Estrategia estrategiaEspera = {
+  .nombre = "espera",
+  .descripcion = "mutex global; sin lugar gira un poco y después duerme en un futex",
+  .iniciar = esperaIniciar,
+  .entrar = esperaEntrar,
+  .salir = esperaSalir,
+  .destruir = esperaDestruir,
+  .barreraAlFinal = 0,
+  .resumen = NULL,
+};
+
+static const Estrategia estrategiaBarrera = {
+  .nombre = "barrera",
+  .descripcion = "como espera, y cada hilo espera al final en una barrera",
+  .iniciar = esperaIniciar,
+  .entrar = esperaEntrar,
+  .salir = esperaSalir,
+  .destruir = esperaDestruir,
+  .barreraAlFinal = 1,
+  .resumen = NULL,
+};
+
+#endif
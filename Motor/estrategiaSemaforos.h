@@ -0,0 +1,89 @@
+// ESTRATEGIA "semaforos": UN SEMÁFORO POR ESTACIÓN Y TRASPASO DIRECTO DE PLAZAS
+//
+// La de mantenimientoDeTeslas.c: cada estación es un semáforo con su capacidad y se
+// entra con sem_trywait. Quien no encuentra lugar se anota en la fila de
+// Comun/traspaso.h y el auto que sale le pasa su plaza al primero de la fila.
+
+#ifndef ESTRATEGIA_SEMAFOROS_H
+#define ESTRATEGIA_SEMAFOROS_H
+
+#include <semaphore.h> // Para sem_init, sem_trywait, sem_post
+#include "estrategia.h"
+#include "../Comun/afinidad.h"  // Para afinidadReservar (cada estación en la memoria de su nodo)
+#include "../Comun/politicas.h" // Para politicaTomar
+#include "../Comun/registro.h"  // Para registrarEvento
+#include "../Comun/traspaso.h"  // Para la fila de autos esperando
+
+static struct {
+  SemaforoEstacion* semaforos; // Uno por estación (cada uno en su línea), con valor = plazas libres
+  int nEstaciones;
+  int politica;
+  Traspaso traspaso;
+} semaforos;
+
+static int semaforosLibresEn(void* s, int i) {
+  int valor;
+  sem_getvalue(&((SemaforoEstacion*)s)[i].semaforo, &valor);
+  return valor;
+}
+
+static int semaforosOcuparEn(void* s, int i) {
+  return sem_trywait(&((SemaforoEstacion*)s)[i].semaforo) == 0;
+}
+
+static int semaforosTomar(void) {
+  return politicaTomar(semaforos.politica, semaforos.nEstaciones, semaforosLibresEn, semaforosOcuparEn,
+                       semaforos.semaforos);
+}
+
+static void semaforosLiberar(int estacion) {
+  sem_post(&semaforos.semaforos[estacion - 1].semaforo);
+}
+
+static int semaforosIniciar(const Escenario* escenario, int nAutos, int politica) {
+  semaforos.nEstaciones = escenario->nEstaciones;
+  semaforos.politica = politica;
+  semaforos.semaforos = afinidadReservar(escenario->nEstaciones, sizeof(SemaforoEstacion));
+  if (!semaforos.semaforos || traspasoIniciar(&semaforos.traspaso, nAutos) != 0) {
+    afinidadLiberar(semaforos.semaforos, escenario->nEstaciones, sizeof(SemaforoEstacion));
+    return -1;
+  }
+  for (int i = 0; i < escenario->nEstaciones; i++) {
+    sem_init(&semaforos.semaforos[i].semaforo, 0, escenario->capacidades[i]);
+  }
+  return 0;
+}
+
+static int semaforosEntrar(int indiceAuto) {
+  int estacion = semaforosTomar();
+  if (estacion < 0) {
+    registrarEvento(EVENTO_ESPERA, indiceAuto, 0, 0);
+    estacion = traspasoEsperar(&semaforos.traspaso, indiceAuto, semaforosTomar);
+  }
+  return estacion;
+}
+
+static void semaforosSalir(int estacion) {
+  traspasoEntregar(&semaforos.traspaso, estacion, semaforosLiberar);
+}
+
+static void semaforosDestruir(void) {
+  for (int i = 0; i < semaforos.nEstaciones; i++) {
+    sem_destroy(&semaforos.semaforos[i].semaforo);
+  }
+  afinidadLiberar(semaforos.semaforos, semaforos.nEstaciones, sizeof(SemaforoEstacion));
+  traspasoDestruir(&semaforos.traspaso);
+}
+
+static const Estrategia estrategiaSemaforos = {
+  .nombre = "semaforos",
+  .descripcion = "un semáforo por estación y traspaso directo de plazas",
+  .iniciar = semaforosIniciar,
+  .entrar = semaforosEntrar,
+  .salir = semaforosSalir,
+  .destruir = semaforosDestruir,
+  .barreraAlFinal = 0,
+  .resumen = NULL,
+};
+
+#endif
@@ -0,0 +1,255 @@
+// LÍNEA DE MONTAJE: CADA TAREA ES UNA ETAPA CON SUS PROPIAS BAHÍAS (--linea)
+//
+// En las estrategias un auto ocupa una plaza de una estación y hace ahí sus tareas una
+// después de otra: la plaza queda tomada mientras dure la más lenta de todas. En la
+// línea cada tarea (BATERÍA, MOTOR, ...) es una etapa con sus bahías, y los autos pasan
+// de una etapa a la siguiente por una cola acotada:
+//
+//   autos -> [cola 1] -> bahías de la tarea 1 -> [cola 2] -> bahías de la tarea 2 -> ...
+//
+// Cada bahía es un hilo que saca el siguiente auto de la cola de su etapa, le hace la
+// tarea (si su perfil la incluye) y lo pone en la cola de la etapa siguiente. Si esa
+// cola está llena, la bahía se queda con el auto hasta que haya lugar (así una etapa
+// lenta frena a las de antes en vez de acumular autos sin límite). main pone los autos
+// en la primera cola en orden de número.
+//
+// Las bahías y el largo de cada cola salen de la directiva "etapa" del escenario (ver
+// escenario.h). Por defecto las plazas de todas las estaciones se reparten por igual
+// entre las etapas (la misma cantidad de puestos que con estaciones completas) y cada
+// cola tiene un lugar por bahía. Al final se imprime, por etapa, cuántos autos atendió
+// por segundo, qué parte del tiempo estuvieron ocupadas sus bahías, cuánto esperaron
+// bloqueadas con un auto terminado y la ocupación media y máxima de su cola: la etapa
+// con las bahías siempre ocupadas y la cola llena es la que hay que agrandar.
+
+#ifndef LINEA_DE_MONTAJE_H
+#define LINEA_DE_MONTAJE_H
+
+#include <pthread.h>            // Para los hilos de las bahías y las colas entre etapas
+#include <stdatomic.h>          // Para los contadores de cada etapa
+#include <stdint.h>             // Para uint64_t
+#include <stdio.h>              // Para printf
+#include <stdlib.h>             // Para malloc, calloc, free
+#include "../Comun/escenario.h" // Para las tareas, sus duraciones, los perfiles y la directiva "etapa"
+#include "../Comun/registro.h"  // Para registrarEvento y relojNs
+
+// Cola acotada de autos a la entrada de una etapa (anillo con mutex y dos condiciones)
+typedef struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t hayLugar, hayAutos;
+  int* autos;                 // Anillo de "capacidad" lugares
+  int capacidad, primero, largo;
+  int porSacar;               // Autos que todavía van a salir de esta cola
+  int maximo;                 // Largo máximo que llegó a tener
+  uint64_t ultimoCambioNs;    // Para integrar el largo en el tiempo
+  double autosPorNs;          // Suma de largo * tiempo con ese largo
+} ColaEtapa;
+
+typedef struct {
+  int tarea;                  // Índice de la tarea que hace esta etapa
+  int bahias;
+  ColaEtapa entrada;
+  atomic_llong atendidos;     // Autos a los que se les hizo la tarea
+  atomic_ullong ocupadoNs;    // Suma del tiempo con la tarea en curso
+  atomic_ullong bloqueadoNs;  // Suma del tiempo esperando lugar en la cola siguiente
+} EtapaLinea;
+
+static struct {
+  const Escenario* escenario;
+  EtapaLinea* etapas;
+  int nEtapas;
+} linea;
+
+static int colaEtapaIniciar(ColaEtapa* c, int capacidad, int nAutos) {
+  c->autos = malloc(sizeof(int) * capacidad);
+  if (!c->autos) {
+    return -1;
+  }
+  pthread_mutex_init(&c->mutex, NULL);
+  pthread_cond_init(&c->hayLugar, NULL);
+  pthread_cond_init(&c->hayAutos, NULL);
+  c->capacidad = capacidad;
+  c->primero = c->largo = c->maximo = 0;
+  c->porSacar = nAutos;
+  c->ultimoCambioNs = relojNs();
+  c->autosPorNs = 0;
+  return 0;
+}
+
+static void colaEtapaDestruir(ColaEtapa* c) {
+  pthread_mutex_destroy(&c->mutex);
+  pthread_cond_destroy(&c->hayLugar);
+  pthread_cond_destroy(&c->hayAutos);
+  free(c->autos);
+}
+
+// Acumula el largo actual hasta ahora (con el mutex de la cola)
+static void colaEtapaIntegrar(ColaEtapa* c) {
+  uint64_t ahora = relojNs();
+  c->autosPorNs += (double)c->largo * (ahora - c->ultimoCambioNs);
+  c->ultimoCambioNs = ahora;
+}
+
+// Pone el auto al final; espera mientras la cola esté llena
+static void colaEtapaPoner(ColaEtapa* c, int indiceAuto) {
+  pthread_mutex_lock(&c->mutex);
+  while (c->largo == c->capacidad) {
+    pthread_cond_wait(&c->hayLugar, &c->mutex);
+  }
+  colaEtapaIntegrar(c);
+  c->autos[(c->primero + c->largo++) % c->capacidad] = indiceAuto;
+  if (c->largo > c->maximo) {
+    c->maximo = c->largo;
+  }
+  pthread_cond_signal(&c->hayAutos);
+  pthread_mutex_unlock(&c->mutex);
+}
+
+/* ---------------------------------------------------------
+Saca el primer auto de la cola y devuelve su número, o 0 si
+ya salieron todos. La bahía se reserva el auto antes de
+esperar ("porSacar"), así que nunca se queda esperando uno
+que no va a llegar.
+------------------------------------------------------------*/
+static int colaEtapaSacar(ColaEtapa* c) {
+  pthread_mutex_lock(&c->mutex);
+  if (c->porSacar == 0) {
+    pthread_mutex_unlock(&c->mutex);
+    return 0;
+  }
+  c->porSacar--;
+  while (c->largo == 0) {
+    pthread_cond_wait(&c->hayAutos, &c->mutex);
+  }
+  colaEtapaIntegrar(c);
+  int indiceAuto = c->autos[c->primero];
+  c->primero = (c->primero + 1) % c->capacidad;
+  c->largo--;
+  pthread_cond_signal(&c->hayLugar);
+  pthread_mutex_unlock(&c->mutex);
+  return indiceAuto;
+}
+
+/* ---------------------------------------------------------
+Cada bahía ejecuta esta función: saca autos de la cola de su
+etapa, les hace la tarea y los pasa a la etapa siguiente (o
+los da por terminados si es la última).
+------------------------------------------------------------*/
+static void* lineaBahia(void* arg) {
+  EtapaLinea* etapa = arg;
+  int numero = (int)(etapa - linea.etapas) + 1; // La etapa hace de "estación" en los mensajes
+  int indiceAuto;
+  while ((indiceAuto = colaEtapaSacar(&etapa->entrada)) > 0) {
+    registrarEvento(EVENTO_INGRESO, indiceAuto, numero, 0);
+    if (escenarioHaceTarea(linea.escenario, indiceAuto, etapa->tarea)) {
+      registrarEvento(EVENTO_INICIO_TAREA, indiceAuto, numero, etapa->tarea);
+      uint64_t inicioNs = relojNs();
+      dormirNs(escenarioDuracionNs(linea.escenario, indiceAuto, etapa->tarea));
+      atomic_fetch_add_explicit(&etapa->ocupadoNs, relojNs() - inicioNs, memory_order_relaxed);
+      atomic_fetch_add_explicit(&etapa->atendidos, 1, memory_order_relaxed);
+      registrarEvento(EVENTO_FIN_TAREA, indiceAuto, numero, etapa->tarea);
+    }
+    if (numero == linea.nEtapas) {
+      registrarEvento(EVENTO_FIN_TODO, indiceAuto, numero, 0);
+      continue;
+    }
+    uint64_t esperaNs = relojNs();
+    colaEtapaPoner(&linea.etapas[numero].entrada, indiceAuto);
+    atomic_fetch_add_explicit(&etapa->bloqueadoNs, relojNs() - esperaNs, memory_order_relaxed);
+  }
+  return NULL;
+}
+
+// Resumen de cada etapa de una corrida que duró "duracionNs"
+static void lineaImprimir(uint64_t duracionNs) {
+  double segundos = duracionNs / 1e9;
+  printf("Línea de montaje: %d autos en %.3f s (%.1f autos/s)\n", linea.escenario->nAutos, segundos,
+         segundos > 0 ? linea.escenario->nAutos / segundos : 0.0);
+  for (int i = 0; i < linea.nEtapas; i++) {
+    EtapaLinea* etapa = &linea.etapas[i];
+    long long atendidos = atomic_load(&etapa->atendidos);
+    double ocupado = (double)atomic_load(&etapa->ocupadoNs);
+    printf("Etapa %d (%s): %d bahías, %lld autos (%.1f/s), ocupadas %.1f%%, bloqueadas %.3f s, "
+           "cola media %.2f y máxima %d de %d\n",
+           i + 1, linea.escenario->nombresTareas[etapa->tarea], etapa->bahias, atendidos,
+           segundos > 0 ? atendidos / segundos : 0.0,
+           duracionNs ? 100.0 * ocupado / ((double)duracionNs * etapa->bahias) : 0.0,
+           atomic_load(&etapa->bloqueadoNs) / 1e9,
+           duracionNs ? etapa->entrada.autosPorNs / duracionNs : 0.0, etapa->entrada.maximo,
+           etapa->entrada.capacidad);
+  }
+}
+
+/* ---------------------------------------------------------
+Corre todos los autos del escenario por la línea: arma las
+etapas, crea sus bahías, pone los autos en la primera cola y
+espera a que terminen. Devuelve los segundos que tardó o -1 si
+no hay memoria o no se pudieron crear los hilos.
+------------------------------------------------------------*/
+static double lineaCorrer(const Escenario* escenario) {
+  // 1) ARMAR LAS ETAPAS
+  // ---------------------------------------------------
+  linea.escenario = escenario;
+  linea.nEtapas = escenario->nTareas;
+  linea.etapas = calloc(linea.nEtapas, sizeof(EtapaLinea));
+  if (!linea.etapas) {
+    return -1;
+  }
+  // Por defecto, las plazas de las estaciones repartidas por igual (al menos una bahía)
+  long long porDefecto = escenario->plazasTotales / linea.nEtapas;
+  if (porDefecto < 1) {
+    porDefecto = 1;
+  }
+  int nBahias = 0;
+  for (int i = 0; i < linea.nEtapas; i++) {
+    EtapaLinea* etapa = &linea.etapas[i];
+    etapa->tarea = i;
+    etapa->bahias = escenario->bahiasEtapa[i] ? escenario->bahiasEtapa[i] : (int)porDefecto;
+    // Más bahías que autos no sirven de nada
+    if (etapa->bahias > escenario->nAutos && escenario->nAutos > 0) {
+      etapa->bahias = escenario->nAutos;
+    }
+    int lugares = escenario->colaEtapa[i] ? escenario->colaEtapa[i] : etapa->bahias;
+    if (colaEtapaIniciar(&etapa->entrada, lugares, escenario->nAutos) != 0) {
+      return -1;
+    }
+    nBahias += etapa->bahias;
+  }
+
+  // 2) CREAR LAS BAHÍAS Y LLENAR LA PRIMERA COLA
+  // ---------------------------------------------------
+  pthread_t* hilos = malloc(sizeof(pthread_t) * nBahias);
+  if (!hilos) {
+    return -1;
+  }
+  uint64_t inicioNs = relojNs();
+  for (int i = 0, h = 0; i < linea.nEtapas; i++) {
+    linea.etapas[i].entrada.ultimoCambioNs = inicioNs;
+    for (int b = 0; b < linea.etapas[i].bahias; b++) {
+      if (pthread_create(&hilos[h++], NULL, lineaBahia, &linea.etapas[i]) != 0) {
+        return -1;
+      }
+    }
+  }
+  for (int indiceAuto = 1; indiceAuto <= escenario->nAutos; indiceAuto++) {
+    colaEtapaPoner(&linea.etapas[0].entrada, indiceAuto);
+  }
+
+  // 3) ESPERAR, RESUMIR Y LIMPIAR
+  // ---------------------------------------------------
+  for (int h = 0; h < nBahias; h++) {
+    pthread_join(hilos[h], NULL);
+  }
+  uint64_t duracionNs = relojNs() - inicioNs;
+  for (int i = 0; i < linea.nEtapas; i++) {
+    colaEtapaIntegrar(&linea.etapas[i].entrada); // El último tramo (ya vacía) no suma
+  }
+  lineaImprimir(duracionNs);
+  for (int i = 0; i < linea.nEtapas; i++) {
+    colaEtapaDestruir(&linea.etapas[i].entrada);
+  }
+  free(linea.etapas);
+  free(hilos);
+  return duracionNs / 1e9;
+}
+
+#endif
@@ -0,0 +1,304 @@
+// LLEGADAS ABIERTAS CON SALA DE ESPERA ACOTADA (directivas "llegadas" y "sala", --carga)
+//
+// Sin la directiva "llegadas" todos los autos arrancan juntos en t = 0: una ráfaga
+// cerrada que no se parece al tránsito de verdad. Con ella main crea cada auto recién
+// a su hora de llegada, que sale del escenario (ver escenario.h):
+//
+//   poisson  tiempos entre llegadas exponenciales con la tasa dada
+//   rafagas  grupos de autos que llegan juntos; los grupos llegan como en poisson
+//   diurna   poisson con una tasa que sube y baja como un seno (entre 0.1 y 1.9 veces
+//            la media) con el ciclo dado, por adelgazamiento (thinning)
+//
+// El auto que llega entra a la sala y enseguida pide plaza con la estrategia elegida,
+// compitiendo con todos los que esperan: la sala son los autos que llegaron y todavía
+// no tienen plaza. Su capacidad (directiva "sala", sin ella no hay límite) acota
+// cuántos pueden estar esperando a la vez; los que están en servicio no cuentan. Si
+// la sala está llena, según "sala":
+//
+//   bloquear   main espera a que alguno consiga plaza para crear el auto (la fuente se frena)
+//   rechazar   el auto que llega se va sin atenderse
+//   descartar  se va el que más esperó y el que llega ocupa su lugar
+//
+// El descartado ya puede estar dormido en la estrategia, que no sabe sacar a nadie
+// de su fila: sale de la sala enseguida y, cuando le toca la plaza, la devuelve sin
+// atenderse. Cada auto tiene una casilla con su estado en la sala. Con --carga
+// la misma corrida se repite con la tasa multiplicada por cada factor y al final se
+// imprime, por factor, la carga ofrecida contra la capacidad estimada (plazas sobre el
+// servicio medio), lo atendido, lo perdido y los percentiles de espera y de tiempo
+// total: el codo donde la espera se dispara es donde el centro se satura.
+
+#ifndef LLEGADAS_H
+#define LLEGADAS_H
+
+#include <math.h>                 // Para log, sin, exp
+#include <pthread.h>              // Para el mutex de la sala y la condición de main
+#include <stdatomic.h>            // Para las casillas y los histogramas
+#include <stdint.h>               // Para uint64_t
+#include <stdio.h>                // Para printf
+#include <stdlib.h>               // Para malloc, calloc, free
+#include <string.h>               // Para memset
+#include "../Comun/escenario.h"   // Para LLEGADAS_*, SALA_*, el azar y las duraciones
+#include "../Comun/latencias.h"   // Para las cubetas y los percentiles
+#include "../Comun/prioridades.h" // Para MEDIDA_ESPERA y MEDIDA_TOTAL
+#include "../Comun/registro.h"    // Para relojNs
+#include "../Comun/tablero.h"     // Para publicar las llegadas, la sala y los perdidos (--tablero)
+
+// Estados de la casilla de cada auto
+#define SALA_ESPERA 0 // En la sala, pidiendo plaza a la estrategia
+#define SALA_PASA 1   // Tiene plaza
+#define SALA_FUERA 2  // Rechazado o descartado: se va sin atenderse
+
+// Corriente de azar de las horas de llegada (las de los autos son indiceAuto * MAX_TAREAS + tarea)
+#define LLEGADAS_CORRIENTE (~0ull)
+
+// Resultado de una corrida con llegadas (una fila de la tabla de --carga)
+typedef struct {
+  double factor;
+  double ofrecida, capacidad; // Autos por segundo
+  double atendida;            // Autos atendidos por segundo
+  long long rechazados, descartados;
+  double espera50, espera99, total50, total99;
+} ResultadoCarga;
+
+static struct {
+  int activas;                // 1 = el escenario trae "llegadas"
+  const Escenario* escenario;
+  int nAutos;
+  double tasa;                // Autos por segundo de esta corrida (la del escenario por el factor)
+  double factor;
+  double capacidad;           // Autos por segundo que aguantan las plazas (0 = no se sabe)
+  pthread_mutex_t mutex;      // Protege la fila, el largo de la sala y los contadores
+  pthread_cond_t hayLugar;    // Main espera acá con SALA_BLOQUEAR
+  atomic_int* casillas;       // casillas[i] = SALA_* del auto i+1
+  uint64_t* llegadaNs;        // Hora de llegada de cada auto
+  int* fila;                  // Autos en orden de llegada (los que ya salieron de la sala
+  int primero, ultimo;        // se saltean al buscar a quién descartar)
+  int enSala;                 // Autos en la sala ahora (en SALA_ESPERA)
+  long long rechazados, descartados;
+  int quedanEnRafaga;
+  double proximaS;            // Hora de la próxima llegada, en segundos desde el inicio
+  uint64_t azar;              // Estado de los sorteos de las llegadas (solo main)
+  uint64_t inicioNs, ultimaNs;
+  atomic_llong atendidos;
+  atomic_llong cuentas[N_MEDIDAS][CUBETAS_LATENCIA];
+  atomic_ullong maximos[N_MEDIDAS];
+} llegadas;
+
+// Segundos que dura en promedio cada tarea
+static double llegadasMediaTarea(const DuracionTarea* d) {
+  switch (d->tipo) {
+  case DURACION_EXPONENCIAL:
+    return d->parametro1;
+  case DURACION_LOGNORMAL:
+    return exp(d->parametro1 + d->parametro2 * d->parametro2 / 2);
+  default:
+    return d->parametro1;
+  }
+}
+
+/* ---------------------------------------------------------
+Prepara la sala para una corrida con la tasa del escenario
+multiplicada por "factor". Devuelve -1 si no hay memoria. Si
+el escenario no trae "llegadas" no hace nada.
+------------------------------------------------------------*/
+static int llegadasIniciar(const Escenario* escenario, int nAutos, double factor) {
+  if (escenario->llegadas == LLEGADAS_JUNTAS) {
+    return 0;
+  }
+  llegadas.escenario = escenario;
+  llegadas.nAutos = nAutos;
+  llegadas.factor = factor;
+  llegadas.tasa = escenario->tasaLlegadas * factor;
+  double servicio = 0;
+  for (int i = 0; i < escenario->nTareas; i++) {
+    servicio += llegadasMediaTarea(&escenario->duraciones[i]);
+  }
+  llegadas.capacidad = servicio > 0 ? escenario->plazasTotales / servicio : 0;
+  llegadas.casillas = calloc(nAutos > 0 ? nAutos : 1, sizeof(atomic_int));
+  llegadas.llegadaNs = calloc(nAutos > 0 ? nAutos : 1, sizeof(uint64_t));
+  llegadas.fila = malloc(sizeof(int) * (nAutos > 0 ? nAutos : 1));
+  if (!llegadas.casillas || !llegadas.llegadaNs || !llegadas.fila) {
+    return -1;
+  }
+  pthread_mutex_init(&llegadas.mutex, NULL);
+  pthread_cond_init(&llegadas.hayLugar, NULL);
+  llegadas.primero = llegadas.ultimo = llegadas.enSala = 0;
+  llegadas.rechazados = llegadas.descartados = 0;
+  llegadas.quedanEnRafaga = 0;
+  llegadas.proximaS = 0;
+  llegadas.azar = escenarioSembrar(escenario, LLEGADAS_CORRIENTE); // Mismas horas en cada corrida
+  atomic_store(&llegadas.atendidos, 0);
+  memset(llegadas.cuentas, 0, sizeof(llegadas.cuentas));
+  memset(llegadas.maximos, 0, sizeof(llegadas.maximos));
+  llegadas.activas = 1;
+  return 0;
+}
+
+// Segundos desde la llegada anterior hasta la próxima, que sería en "ahoraS"
+static double llegadasEntreLlegadas(double ahoraS) {
+  const Escenario* e = llegadas.escenario;
+  switch (e->llegadas) {
+  case LLEGADAS_RAFAGAS:
+    if (llegadas.quedanEnRafaga > 0) {
+      llegadas.quedanEnRafaga--;
+      return 0; // Llega con los demás de su ráfaga
+    }
+    llegadas.quedanEnRafaga = (int)(e->parametroLlegadas + 0.5) - 1;
+    return -log(escenarioAzar(&llegadas.azar)) * (e->parametroLlegadas / llegadas.tasa);
+  case LLEGADAS_DIURNAS: {
+    // Candidatas a la tasa máxima; cada una se queda con probabilidad tasa(t) / máxima
+    double maxima = 1.9 * llegadas.tasa, t = ahoraS;
+    do {
+      t += -log(escenarioAzar(&llegadas.azar)) / maxima;
+    } while (escenarioAzar(&llegadas.azar) * 1.9 > 1 + 0.9 * sin(6.283185307179586 * t / e->parametroLlegadas));
+    return t - ahoraS;
+  }
+  default:
+    return -log(escenarioAzar(&llegadas.azar)) / llegadas.tasa;
+  }
+}
+
+/* ---------------------------------------------------------
+Main la llama antes de crear el hilo del auto "indiceAuto"
+(en orden de número): duerme hasta su hora de llegada y lo
+pone en la sala (o lo rechaza o echa al que más esperó,
+según la política de la sala).
+------------------------------------------------------------*/
+static void llegadasLlega(int indiceAuto) {
+  uint64_t ahora = relojNs();
+  if (indiceAuto == 1) {
+    llegadas.inicioNs = ahora;
+  } else {
+    llegadas.proximaS += llegadasEntreLlegadas(llegadas.proximaS);
+    uint64_t horaNs = llegadas.inicioNs + (uint64_t)(llegadas.proximaS * 1e9);
+    if (horaNs > ahora) {
+      dormirNs(horaNs - ahora);
+    }
+  }
+
+  const Escenario* e = llegadas.escenario;
+  pthread_mutex_lock(&llegadas.mutex);
+  if (e->capacidadSala && llegadas.enSala >= e->capacidadSala) {
+    if (e->politicaSala == SALA_RECHAZAR) {
+      atomic_store(&llegadas.casillas[indiceAuto - 1], SALA_FUERA);
+      llegadas.rechazados++;
+      tableroLlegada();
+      tableroRechazo();
+      llegadas.ultimaNs = relojNs();
+      pthread_mutex_unlock(&llegadas.mutex);
+      return;
+    }
+    if (e->politicaSala == SALA_DESCARTAR) {
+      // El primero en la fila que sigue en la sala (los que ya tienen plaza se saltean)
+      int descartado;
+      do {
+        descartado = llegadas.fila[llegadas.primero++];
+      } while (atomic_load(&llegadas.casillas[descartado - 1]) != SALA_ESPERA);
+      atomic_store(&llegadas.casillas[descartado - 1], SALA_FUERA);
+      llegadas.enSala--;
+      llegadas.descartados++;
+      tableroDescarte();
+    } else {
+      while (llegadas.enSala >= e->capacidadSala) {
+        pthread_cond_wait(&llegadas.hayLugar, &llegadas.mutex);
+      }
+      // La fuente se frenó: las próximas llegadas se cuentan desde ahora
+      double demoraS = (relojNs() - llegadas.inicioNs) / 1e9;
+      if (demoraS > llegadas.proximaS) {
+        llegadas.proximaS = demoraS;
+      }
+    }
+  }
+  llegadas.ultimaNs = llegadas.llegadaNs[indiceAuto - 1] = relojNs();
+  llegadas.fila[llegadas.ultimo++] = indiceAuto;
+  llegadas.enSala++;
+  tableroLlegada();
+  tableroSala(llegadas.enSala);
+  pthread_mutex_unlock(&llegadas.mutex);
+}
+
+// Antes de pedir plaza: devuelve 0 si el auto ya se tiene que ir sin atenderse
+static int salaEsperar(int indiceAuto) {
+  return atomic_load(&llegadas.casillas[indiceAuto - 1]) != SALA_FUERA;
+}
+
+// El auto consiguió plaza y deja la sala; devuelve 0 si lo descartaron mientras
+// esperaba (entonces tiene que devolver la plaza e irse sin atenderse)
+static int salaPasar(int indiceAuto) {
+  pthread_mutex_lock(&llegadas.mutex);
+  int estado = SALA_ESPERA;
+  int pasa = atomic_compare_exchange_strong(&llegadas.casillas[indiceAuto - 1], &estado, SALA_PASA);
+  if (pasa) {
+    llegadas.enSala--;
+    tableroSala(llegadas.enSala);
+    pthread_cond_signal(&llegadas.hayLugar);
+  }
+  pthread_mutex_unlock(&llegadas.mutex);
+  if (pasa) {
+    latenciasAnotarEn(llegadas.cuentas[MEDIDA_ESPERA], &llegadas.maximos[MEDIDA_ESPERA],
+                      relojNs() - llegadas.llegadaNs[indiceAuto - 1]);
+  }
+  return pasa;
+}
+
+// El auto terminó y devolvió su plaza
+static void salaSalir(int indiceAuto) {
+  latenciasAnotarEn(llegadas.cuentas[MEDIDA_TOTAL], &llegadas.maximos[MEDIDA_TOTAL],
+                    relojNs() - llegadas.llegadaNs[indiceAuto - 1]);
+  atomic_fetch_add_explicit(&llegadas.atendidos, 1, memory_order_relaxed);
+}
+
+// Percentil "q" de una medida (en segundos, acotado por el máximo)
+static double llegadasPercentil(int medida, double q, long long* n) {
+  long long cuentas[CUBETAS_LATENCIA];
+  *n = 0;
+  for (int c = 0; c < CUBETAS_LATENCIA; c++) {
+    cuentas[c] = atomic_load_explicit(&llegadas.cuentas[medida][c], memory_order_relaxed);
+    *n += cuentas[c];
+  }
+  return *n ? fmin(latenciasPercentil(cuentas, *n, q), atomic_load(&llegadas.maximos[medida]) / 1e9) : 0;
+}
+
+/* ---------------------------------------------------------
+Resume la corrida que duró "duracion" segundos en "r", imprime
+sus percentiles y libera la sala (llamar después de que
+terminaron los hilos).
+------------------------------------------------------------*/
+static void llegadasTerminar(double duracion, ResultadoCarga* r) {
+  if (!llegadas.activas) {
+    return;
+  }
+  long long n;
+  double tramo = (llegadas.ultimaNs - llegadas.inicioNs) / 1e9;
+  r->factor = llegadas.factor;
+  r->ofrecida = tramo > 0 ? (llegadas.nAutos - 1) / tramo : 0;
+  r->capacidad = llegadas.capacidad;
+  r->atendida = duracion > 0 ? atomic_load(&llegadas.atendidos) / duracion : 0;
+  r->rechazados = llegadas.rechazados;
+  r->descartados = llegadas.descartados;
+  r->espera50 = llegadasPercentil(MEDIDA_ESPERA, 0.5, &n);
+  r->espera99 = llegadasPercentil(MEDIDA_ESPERA, 0.99, &n);
+  r->total50 = llegadasPercentil(MEDIDA_TOTAL, 0.5, &n);
+  r->total99 = llegadasPercentil(MEDIDA_TOTAL, 0.99, &n);
+  printf("Llegadas: %lld atendidos, %lld rechazados y %lld descartados; espera p99 %.6f s, total p99 %.6f s\n",
+         (long long)atomic_load(&llegadas.atendidos), r->rechazados, r->descartados, r->espera99, r->total99);
+
+  pthread_mutex_destroy(&llegadas.mutex);
+  pthread_cond_destroy(&llegadas.hayLugar);
+  free(llegadas.casillas);
+  free(llegadas.llegadaNs);
+  free(llegadas.fila);
+  llegadas.activas = 0;
+}
+
+// Una fila de la tabla de carga ofrecida contra latencia
+static void llegadasImprimirCarga(const char* estrategia, const ResultadoCarga* r) {
+  printf("Carga x%.2f con %-10s: ofrecida %.1f autos/s", r->factor, estrategia, r->ofrecida);
+  if (r->capacidad > 0) {
+    printf(" (%.0f%% de %.1f)", 100 * r->ofrecida / r->capacidad, r->capacidad);
+  }
+  printf(", atendida %.1f autos/s, perdidos %lld, espera p50 %.6f s p99 %.6f s, total p50 %.6f s p99 %.6f s\n",
+         r->atendida, r->rechazados + r->descartados, r->espera50, r->espera99, r->total50, r->total99);
+}
+
+#endif
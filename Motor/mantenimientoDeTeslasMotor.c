@@ -0,0 +1,636 @@
+// CENTROS DE MANTENIMIENTO DE TESLAS: UN SOLO MOTOR CON LA ESTRATEGIA Y EL ORDEN DE ENTRADA ELEGIDOS AL EJECUTAR
+//
+// Uso: ./motor mantenimientoConfig.txt [--estrategia <nombre|todas>] [--entrada <ordenada|desordenada>]
+//      [--pool] [--log-async] [--traza <archivo>] [--politica <...>] [--pestillo] [--latencias]
+//      [--tablero /nombre] [--linea] [--tecnicos <n>] [--carga <f1,f2,...>] [--fibras] [--resumen]
+//
+// Es el núcleo de los programas de "Entrada Ordenada" y "Entrada Desordenada" escrito
+// una sola vez: lo único que cambia entre ellos (cómo un auto consigue plaza y cómo
+// la devuelve) es una Estrategia (ver estrategia.h). Cada uno de esos programas es un
+// Programa (ver programa.h) que elige su estrategia, su entrada y sus opciones y
+// compila este mismo archivo. --lockfree no se usa acá (es la estrategia "atomica"),
+// ni --combinar (es "combinada"), ni --simulacion ni --fases (solo en sus programas).
+// Con --fibras los autos no son hilos sino fibras (ver autosFibra.h).
+// Con --linea las tareas no se hacen en una estación sino en una línea de montaje con
+// una etapa por tarea (ver lineaDeMontaje.h) y con --tecnicos las hacen los técnicos de
+// la estación, varias a la vez (ver tecnicos.h). Si el escenario trae "llegadas", los
+// autos llegan de a poco y esperan en una sala acotada (ver llegadas.h).
+
+#define _XOPEN_SOURCE 600
+#include <pthread.h> // Para crear y manejar hilos (pthread_create, pthread_join, barrier, etc.)
+#include <errno.h>   // Para EAGAIN
+#include <stdio.h>   // Para printf, perror
+#include <stdlib.h>  // Para malloc, free, exit
+#include <string.h>  // Para strcmp
+#include "../Comun/opciones.h"     // Para leerOpciones (--estrategia, --entrada, --pool, etc.)
+#include "../Comun/registro.h"     // Para registrarEvento (printf síncrono o escritor asíncrono)
+#include "../Comun/escenario.h"    // Para leer el escenario (capacidades, tareas y perfiles)
+#include "../Comun/politicas.h"    // Para elegir estación con --politica y medir cada estación
+#include "../Comun/latencias.h"   // Para --latencias (percentiles de cada fase de cada auto)
+#include "../Comun/prioridades.h" // Para --prioridades (clases flota, garantía y particular)
+#include "../Comun/tablero.h"     // Para --tablero (contadores en vivo en memoria compartida)
+#include "../Comun/afinidad.h"    // Para --afinidad (hilos fijados al núcleo de una estación)
+#include "../Comun/secuenciador.h" // Para el turno de --entrada ordenada
+#include "../Comun/pestillo.h"     // Para --pestillo y --fases (cuenta regresiva sin barrera ni join)
+#include "../Comun/simulacion.h"   // Para --simulacion (reloj virtual, sin hilos)
+#include "programa.h"
+#include "estrategiaSemaforos.h"
+#include "estrategiaCondicion.h"
+#include "estrategiaEspera.h"
+#include "estrategiaColas.h"
+#include "estrategiaAtomica.h"
+#include "estrategiaCombinada.h"
+#include "lineaDeMontaje.h"
+#include "tecnicos.h"
+#include "llegadas.h"
+#include "autosFibra.h"
+
+// El motor solo, sin un programa de "Entrada Ordenada" o "Entrada Desordenada" que lo incluya
+#ifndef PROGRAMA_MOTOR
+static const Programa programa = {
+  .estrategia = "semaforos",
+  .opciones = OPCIONES_COMUNES | OPCION_POOL | OPCION_PESTILLO | OPCION_ESTRATEGIA | OPCION_ENTRADA |
+              OPCION_LINEA | OPCION_TECNICOS | OPCION_CARGA | OPCION_FIBRAS,
+};
+#endif
+
+// ------- VARIABLES GLOBALES ----------
+
+// Estrategias que se pueden elegir con --estrategia (la primera es la de siempre)
+const Estrategia* estrategias[] = {
+  &estrategiaSemaforos, &estrategiaCondicion, &estrategiaEspera,
+  &estrategiaBarrera,   &estrategiaColas,     &estrategiaAtomica,
+  &estrategiaCombinada,
+};
+#define N_ESTRATEGIAS (int)(sizeof(estrategias) / sizeof(estrategias[0]))
+
+// Estrategia de la corrida en curso
+const Estrategia* estrategia;
+
+// Factores de la tasa de llegadas (--carga), el de la corrida en curso y su resultado
+#define MAX_CARGAS 16
+double cargas[MAX_CARGAS] = {1};
+int nCargas = 1;
+double factorCarga = 1;
+ResultadoCarga resultadoCarga;
+
+// Mutex para que los printf no se mezclen en consola
+pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Con --entrada ordenada, cada auto espera en su casilla a que el anterior le pase el turno
+Secuenciador secuenciador;
+
+// Barrera del final (solo estrategias o programas con barreraAlFinal, y sin --pestillo)
+pthread_barrier_t barrera;
+// Con --pestillo cada hilo baja este pestillo al terminar y main espera a que llegue a 0
+Pestillo hilosTerminados;
+// Con --fases, un pestillo por tarea con la cantidad de autos que la hacen
+Pestillo* fases;
+int* autosPorFase;
+
+// Cantidad de autos y cuántas estaciones (copiados del escenario)
+int nAutos = 0, nEstaciones = 0;
+// Escenario leído del archivo: capacidad de cada estación, tareas y perfiles de autos
+Escenario escenario;
+
+// Opciones de línea de comandos (estrategia, orden de entrada, modo pool, etc.)
+Opciones opciones;
+
+// Cola de admisión compartida del modo pool: el siguiente auto a atender
+pthread_mutex_t colaMutex = PTHREAD_MUTEX_INITIALIZER;
+int siguienteAuto = 1;
+
+// Línea del final (la del programa, si tiene una propia)
+const char* textoFinal =
+  "Todos los vehículos han completado su mantenimiento y están listos para volver a la carretera\n";
+
+// Nombres de las 4 tareas de siempre (las que se usan si el escenario no trae otras)
+char* tareas[] = {"BATERÍA", "MOTOR", "DIRECCIÓN", "SISTEMA DE NAVEGACIÓN"};
+// Texto de cada evento del auto, en el orden de EVENTO_* (ver Comun/registro.h)
+const char* formatosEvento[N_TIPOS_EVENTO] = {
+  "Vehículo %d ha ingresado a la estación de mantenimiento %d.\n",
+  "Vehículo %d está esperando para ingresar a alguna estación de mantenimiento.\n",
+  "Vehículo %d ha iniciado el mantenimiento de la %s en la estación %d.\n",
+  "Vehículo %d ha completado el mantenimiento de la %s en la estación %d.\n",
+  "Vehículo %d ha completado TODO su mantenimiento.\n",
+};
+
+// Busca la estrategia por nombre (NULL si no existe)
+const Estrategia* estrategiaPorNombre(const char* nombre);
+// Corre todos los autos con la estrategia dada; devuelve los segundos que tardó o -1
+double correrEstrategia(const Estrategia* e);
+// Firma de la función que ejecuta cada hilo (cada auto)
+void* autoRoutine(void* arg);
+// Firma de la función que ejecuta cada hilo trabajador del modo pool
+void* trabajadorRoutine(void* arg);
+// Trabajo completo de un auto (turno, estación, tareas y salida)
+void atenderAuto(int indiceAuto);
+// Con --fases, imprime cuándo terminaron todos los autos cada tarea
+void imprimirFases(uint64_t inicioNs);
+// Crea un hilo (reintenta si el sistema no tiene lugar y hay hilos por terminar)
+void crearHilo(pthread_t* hilo, pthread_attr_t* atributos, void* (*rutina)(void*), void* arg);
+// Final de cada hilo: barrera (si la estrategia la usa) o bajar el pestillo (--pestillo)
+void terminarHilo(void);
+
+int main(int argc, char const* argv[]) {
+  // 1) LEER ARGUMENTOS Y ARCHIVO
+  // ---------------------------------------------------
+  if (argc < 2) {
+    perror("Faltan argumentos \n"); // Si no se da el archivo con los números
+    return EXIT_FAILURE;
+  }
+  // Cada programa acepta solo sus opciones (las del motor solo, sin programa, son todas estas)
+  if (leerOpciones(argc, argv, &opciones, programa.opciones) != 0) {
+    return EXIT_FAILURE;
+  }
+  opciones.entradaOrdenada |= programa.entradaOrdenada;
+  opciones.fibras |= programa.fibras;
+  // Con el archivo de 3 números cada tarea dura lo que diga el programa (0 en el motor solo)
+  if (escenarioLeer(argv[1], &escenario, tareas, 4, programa.duracionNs) != 0) {
+    perror("Error al leer el archivo o el escenario\n");
+    return EXIT_FAILURE;
+  }
+  nAutos = escenario.nAutos;
+  nEstaciones = escenario.nEstaciones;
+  for (int i = 0; i < N_TIPOS_EVENTO; i++) {
+    if (programa.formatos[i]) {
+      formatosEvento[i] = programa.formatos[i];
+    }
+  }
+  if (programa.textoFinal) {
+    textoFinal = programa.textoFinal;
+  }
+
+  // Con llegadas abiertas cada auto es un hilo que se crea a su hora, y algunos no entran
+  if (escenario.llegadas != LLEGADAS_JUNTAS &&
+      (opciones.modoPool || opciones.entradaOrdenada || opciones.fibras || opciones.simulacion)) {
+    fprintf(stderr, "Con \"llegadas\" en el escenario no se usan --pool, --entrada ordenada, --fibras "
+                    "ni --simulacion\n");
+    return EXIT_FAILURE;
+  }
+  // Las fibras tienen sus propias plazas: no hay estrategia, pool, técnicos ni línea
+  if (opciones.fibras && (opciones.modoPool || opciones.pestilloFinal || opciones.estrategia ||
+                          opciones.tecnicos || opciones.linea)) {
+    fprintf(stderr, "--fibras no se usa con --pool, --pestillo, --estrategia, --tecnicos ni --linea\n");
+    return EXIT_FAILURE;
+  }
+  if (opciones.cargas) {
+    char* resto = (char*)opciones.cargas;
+    nCargas = 0;
+    while (*resto && nCargas < MAX_CARGAS) {
+      cargas[nCargas] = strtod(resto, &resto);
+      if (cargas[nCargas++] <= 0 || (*resto && *resto++ != ',')) {
+        nCargas = 0;
+        break;
+      }
+    }
+    if (nCargas == 0 || escenario.llegadas == LLEGADAS_JUNTAS) {
+      fprintf(stderr, "--carga necesita factores positivos separados por comas y \"llegadas\" en el escenario\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Con --afinidad cada estación tiene su núcleo y su nodo NUMA (antes de reservar su estado)
+  if (opciones.afinidad && afinidadIniciar(nEstaciones) != 0) {
+    perror("No se pudo leer la topología de CPUs para --afinidad\n");
+    return EXIT_FAILURE;
+  }
+
+  // 2) ELEGIR LA ESTRATEGIA (O TODAS)
+  // ---------------------------------------------------
+  const Estrategia* elegidas[N_ESTRATEGIAS];
+  int nElegidas = 0;
+  if (opciones.fibras) {
+    nElegidas = 0; // Las fibras no usan estrategia (ver autosFibra.h)
+  } else if (opciones.estrategia && strcmp(opciones.estrategia, "todas") == 0) {
+    for (int i = 0; i < N_ESTRATEGIAS; i++) {
+      elegidas[nElegidas++] = estrategias[i];
+    }
+  } else {
+    // Sin --estrategia, la del programa (--lockfree y --combinar la cambian en sus variantes)
+    const char* nombre = programa.estrategia;
+    if (opciones.estrategia) {
+      nombre = opciones.estrategia;
+    } else if (opciones.estacionesLockFree) {
+      nombre = "atomica";
+    } else if (opciones.combinar) {
+      nombre = "combinada";
+    }
+    elegidas[0] = estrategiaPorNombre(nombre);
+    if (!elegidas[0]) {
+      fprintf(stderr, "Estrategia desconocida: %s. Las que hay son:\n", opciones.estrategia);
+      for (int i = 0; i < N_ESTRATEGIAS; i++) {
+        fprintf(stderr, "  %-10s %s\n", estrategias[i]->nombre, estrategias[i]->descripcion);
+      }
+      fprintf(stderr, "  %-10s una después de otra, en el mismo proceso\n", "todas");
+      escenarioDestruir(&escenario);
+      return EXIT_FAILURE;
+    }
+    nElegidas = 1;
+  }
+
+  // Registro de eventos: printf con mutex (original), anillos por hilo con --log-async,
+  // traza binaria con --traza (una sola para todas las corridas) o nada con --resumen
+  if (registroIniciar(formatosEvento, escenario.nombresTareas, escenario.nTareas, &mutex,
+                      opciones.registroAsincrono, opciones.archivoTraza, opciones.soloResumen) != 0) {
+    perror("No se pudo iniciar el registro de eventos (traza o hilo escritor)\n");
+    return EXIT_FAILURE;
+  }
+
+  // Con --simulacion no se crean hilos: el mismo modelo corre en un reloj virtual
+  // (cada tarea dura lo que indica el escenario, en tiempo virtual) y el programa termina acá
+  if (opciones.simulacion) {
+    Simulacion sim;
+    if (simulacionEjecutar(&sim, &escenario) != 0) {
+      perror("No se pudo reservar memoria para la simulación\n");
+      return EXIT_FAILURE;
+    }
+    registroTerminar();
+    printf("%s", textoFinal);
+    simulacionImprimirResumen(&sim);
+    simulacionDestruir(&sim);
+    escenarioDestruir(&escenario);
+    return EXIT_SUCCESS;
+  }
+
+  // Un solo tablero para todas las corridas (cada estrategia con cada factor de --carga):
+  // los contadores se acumulan de una a la otra
+  if (opciones.tablero && tableroIniciar(opciones.tablero, nEstaciones, nAutos * nElegidas * nCargas) != 0) {
+    perror("No se pudo crear el tablero en memoria compartida\n");
+    return EXIT_FAILURE;
+  }
+
+  // 3) CORRER CADA ESTRATEGIA
+  // ---------------------------------------------------
+  // Con --linea y sin --estrategia solo corre la línea
+  if (opciones.linea && !opciones.estrategia) {
+    nElegidas = 0;
+  }
+  // Con --carga cada estrategia corre una vez por factor (segundos[] guarda la última)
+  double segundos[N_ESTRATEGIAS];
+  ResultadoCarga resultados[N_ESTRATEGIAS][MAX_CARGAS];
+  for (int i = 0; i < nElegidas; i++) {
+    for (int c = 0; c < nCargas; c++) {
+      factorCarga = cargas[c];
+      segundos[i] = correrEstrategia(elegidas[i]);
+      if (segundos[i] < 0) {
+        perror("No se pudo reservar memoria para la estrategia\n");
+        return EXIT_FAILURE;
+      }
+      resultados[i][c] = resultadoCarga;
+    }
+  }
+  double segundosLinea = 0;
+  if (opciones.linea && (segundosLinea = lineaCorrer(&escenario)) < 0) {
+    perror("No se pudo armar la línea de montaje\n");
+    return EXIT_FAILURE;
+  }
+  if (opciones.fibras) {
+    if (opciones.medirEstaciones && metricasIniciar(nEstaciones) != 0) {
+      perror("No se pudo reservar memoria para las métricas de las estaciones\n");
+      return EXIT_FAILURE;
+    }
+    if (opciones.medirLatencias && latenciasIniciar(escenario.nTareas, escenario.nombresTareas) != 0) {
+      perror("No se pudo reservar memoria para los histogramas de latencia\n");
+      return EXIT_FAILURE;
+    }
+    if (opciones.prioridades) {
+      prioridadesIniciar(&escenario);
+    }
+    if (autosFibraCorrer(&escenario, opciones.politica, opciones.entradaOrdenada) < 0) {
+      perror("No se pudieron crear las fibras o los hilos trabajadores\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  tableroTerminar();
+  // Espero a que el escritor termine de sacar todos los eventos pendientes
+  registroTerminar();
+
+  printf("%s", textoFinal);
+  if (opciones.fibras) {
+    metricasImprimir(opciones.politica, escenario.capacidades);
+    latenciasImprimir();
+    prioridadesImprimir();
+    metricasDestruir();
+    latenciasDestruir();
+  }
+  // Con más de una corrida (varias estrategias, o alguna más la línea), cuánto tardó
+  // cada una con los mismos autos. La línea solo aparece si se corrió con --linea.
+  int nCorridas = nElegidas + opciones.linea;
+  for (int i = 0; nCorridas > 1 && i < nElegidas; i++) {
+    printf("Estrategia %-10s entrada %s: %.3f s\n", elegidas[i]->nombre,
+           opciones.entradaOrdenada ? "ordenada" : "desordenada", segundos[i]);
+  }
+  if (opciones.linea && nCorridas > 1) {
+    printf("Línea de montaje: %.3f s\n", segundosLinea);
+  }
+  // Con llegadas abiertas, la carga ofrecida contra la latencia de cada corrida
+  for (int i = 0; escenario.llegadas != LLEGADAS_JUNTAS && i < nElegidas; i++) {
+    for (int c = 0; c < nCargas; c++) {
+      llegadasImprimirCarga(elegidas[i]->nombre, &resultados[i][c]);
+    }
+  }
+
+  // 4) LIMPIAR RECURSOS
+  // ---------------------------------------------------
+  escenarioDestruir(&escenario);
+
+  return EXIT_SUCCESS;
+}
+
+const Estrategia* estrategiaPorNombre(const char* nombre) {
+  for (int i = 0; i < N_ESTRATEGIAS; i++) {
+    if (strcmp(estrategias[i]->nombre, nombre) == 0) {
+      return estrategias[i];
+    }
+  }
+  return NULL;
+}
+
+/* ---------------------------------------------------------
+Una corrida completa con la estrategia "e": prepara las plazas,
+el turno y el final (barrera o pestillo), crea los hilos, espera
+a que terminen y deja todo como estaba para la siguiente.
+------------------------------------------------------------*/
+double correrEstrategia(const Estrategia* e) {
+  // 1) PREPARAR PLAZAS, TURNO Y MÉTRICAS
+  // ---------------------------------------------------
+  estrategia = e;
+  siguienteAuto = 1;
+  if (estrategia->iniciar(&escenario, nAutos, opciones.politica) != 0) {
+    return -1;
+  }
+  if (opciones.entradaOrdenada && secuenciadorIniciar(&secuenciador, nAutos) != 0) {
+    return -1;
+  }
+  // Con --politica se mide la utilización y la espera de cada estación
+  if (opciones.medirEstaciones && metricasIniciar(nEstaciones) != 0) {
+    return -1;
+  }
+  // Con --latencias cada auto anota cuánto duró cada fase de su recorrido
+  if (opciones.medirLatencias && latenciasIniciar(escenario.nTareas, escenario.nombresTareas) != 0) {
+    return -1;
+  }
+  // Con --prioridades cada auto tiene la clase del escenario (flota, garantía o particular)
+  if (opciones.prioridades) {
+    prioridadesIniciar(&escenario);
+  }
+  // Con --tecnicos cada estación tiene sus técnicos esperando trabajo
+  if (opciones.tecnicos && tecnicosIniciar(&escenario, opciones.tecnicos) != 0) {
+    return -1;
+  }
+  // Con "llegadas" en el escenario, la sala de espera para esta tasa
+  if (llegadasIniciar(&escenario, nAutos, factorCarga) != 0) {
+    return -1;
+  }
+
+  // 2) PREPARAR EL FINAL DE LOS HILOS
+  // ---------------------------------------------------
+  // En modo pool solo hay un hilo por plaza (la suma de las capacidades), sin importar nAutos
+  int nHilos = nAutos;
+  if (opciones.modoPool && escenario.plazasTotales < nAutos) {
+    nHilos = (int)escenario.plazasTotales;
+  }
+  if (opciones.pestilloFinal) {
+    pestilloIniciar(&hilosTerminados, nHilos);
+  } else if (estrategia->barreraAlFinal || programa.barreraAlFinal) {
+    pthread_barrier_init(&barrera, NULL, nHilos);
+  }
+  // Con --fases, cada pestillo arranca en la cantidad de autos cuyo perfil incluye la tarea
+  if (opciones.medirFases) {
+    fases = malloc(sizeof(Pestillo) * (escenario.nTareas > 0 ? escenario.nTareas : 1));
+    autosPorFase = calloc(escenario.nTareas > 0 ? escenario.nTareas : 1, sizeof(int));
+    if (!fases || !autosPorFase) {
+      return -1;
+    }
+    for (int a = 1; a <= nAutos; a++) {
+      for (int i = 0; i < escenario.nTareas; i++) {
+        autosPorFase[i] += escenarioHaceTarea(&escenario, a, i) ? 1 : 0;
+      }
+    }
+    for (int i = 0; i < escenario.nTareas; i++) {
+      pestilloIniciar(&fases[i], autosPorFase[i]);
+    }
+  }
+
+  // 3) CREAR HILOS (AUTOS O TRABAJADORES)
+  // ---------------------------------------------------
+  pthread_t* autos = malloc(sizeof(pthread_t) * (nHilos > 0 ? nHilos : 1));
+  if (!autos) {
+    return -1;
+  }
+  // Con --pestillo los hilos se crean separados (detached): al terminar liberan su pila
+  // solos y nadie les hace join
+  pthread_attr_t atributos;
+  pthread_attr_init(&atributos);
+  if (opciones.pestilloFinal) {
+    pthread_attr_setdetachstate(&atributos, PTHREAD_CREATE_DETACHED);
+  }
+  uint64_t inicioNs = relojNs();
+
+  for (int i = 0; i < nHilos; i++) {
+    if (opciones.modoPool) {
+      // Los trabajadores no necesitan argumento: sacan los autos de la cola
+      crearHilo(&autos[i], &atributos, trabajadorRoutine, NULL);
+      continue;
+    }
+    // Con llegadas abiertas el auto se crea recién a su hora (y ya anotado en la sala)
+    if (llegadas.activas) {
+      llegadasLlega(i + 1);
+    }
+    // Cada hilo necesita saber su "número de auto" (1, 2, 3, ...)
+    int* indiceAuto = malloc(sizeof(int));
+    if (!indiceAuto) {
+      return -1;
+    }
+    *indiceAuto = i + 1;
+    crearHilo(&autos[i], &atributos, autoRoutine, indiceAuto);
+  }
+  pthread_attr_destroy(&atributos);
+
+  // 4) ESPERAR A QUE TERMINEN TODOS LOS HILOS
+  // ---------------------------------------------------
+  if (opciones.pestilloFinal) {
+    pestilloEsperar(&hilosTerminados);
+  } else {
+    for (int i = 0; i < nHilos; i++) {
+      pthread_join(autos[i], NULL);
+    }
+  }
+  double duracion = (relojNs() - inicioNs) / 1e9;
+
+  // 5) RESUMEN Y LIMPIEZA DE ESTA CORRIDA
+  // ---------------------------------------------------
+  if (opciones.tecnicos) {
+    tecnicosTerminar();
+  }
+  llegadasTerminar(duracion, &resultadoCarga);
+  metricasImprimir(opciones.politica, escenario.capacidades);
+  latenciasImprimir();
+  prioridadesImprimir();
+  if (estrategia->resumen) {
+    estrategia->resumen();
+  }
+  metricasDestruir();
+  latenciasDestruir();
+  if (opciones.medirFases) {
+    imprimirFases(inicioNs);
+    free(fases);
+    free(autosPorFase);
+  }
+  if (!opciones.pestilloFinal && (estrategia->barreraAlFinal || programa.barreraAlFinal)) {
+    pthread_barrier_destroy(&barrera);
+  }
+  if (opciones.entradaOrdenada) {
+    secuenciadorDestruir(&secuenciador);
+  }
+  estrategia->destruir();
+  free(autos);
+
+  return duracion;
+}
+
+/* ---------------------------------------------------------
+Cada hilo (auto) ejecuta esta función: solo atiende a su
+propio auto y termina.
+------------------------------------------------------------*/
+void* autoRoutine(void* arg) {
+  afinidadFijarHilo(); // Con --afinidad, al núcleo de una estación (en ronda)
+  // “indiceAuto” = número del auto (1, 2, 3, ..., nAutos)
+  int indiceAuto = *(int*)arg;
+  free(arg); // Ya no necesitamos este puntero en heap
+
+  atenderAuto(indiceAuto);
+  terminarHilo();
+
+  pthread_exit(NULL);
+}
+
+/* ---------------------------------------------------------
+Cada hilo trabajador del modo pool ejecuta esta función:
+saca el siguiente auto de la cola de admisión (en orden) y lo
+atiende, hasta que no quedan autos. Los autos son solo números.
+------------------------------------------------------------*/
+void* trabajadorRoutine(void* arg) {
+  (void)arg;
+  afinidadFijarHilo(); // Con --afinidad, al núcleo de una estación (en ronda)
+  while (1) {
+    pthread_mutex_lock(&colaMutex);
+    int indiceAuto = siguienteAuto++;
+    pthread_mutex_unlock(&colaMutex);
+    if (indiceAuto > nAutos) {
+      break; // Ya no quedan autos en la cola
+    }
+    atenderAuto(indiceAuto);
+  }
+  terminarHilo();
+
+  pthread_exit(NULL);
+}
+
+/* ---------------------------------------------------------
+Trabajo de cada auto:
+0) Con llegadas abiertas, ya está en la sala (ver llegadas.h).
+1) Con --entrada ordenada, espera su turno (secuenciador).
+2) Consigue una plaza con la estrategia elegida.
+3) Realiza las tareas de mantenimiento de su perfil.
+4) Devuelve la plaza con la estrategia elegida.
+------------------------------------------------------------*/
+void atenderAuto(int indiceAuto) {
+  // Con llegadas abiertas se va enseguida si lo rechazaron o ya lo echaron de la sala
+  if (llegadas.activas && !salaEsperar(indiceAuto)) {
+    return;
+  }
+  // Hora de llegada, para medir cuánto espera hasta entrar (--politica)
+  uint64_t llegadaNs = relojNs();
+  // Inicio de la fase en curso (--latencias)
+  uint64_t marcaNs = llegadaNs;
+  // Con llegadas abiertas la llegada ya la contó llegadasLlega
+  if (!llegadas.activas) {
+    tableroLlegada();
+  }
+
+  // 1) ESPERAR SU TURNO ORDENADO
+  // ---------------------------------------------------
+  if (opciones.entradaOrdenada) {
+    secuenciadorEsperar(&secuenciador, indiceAuto);
+    secuenciadorAvanzar(&secuenciador, indiceAuto);
+    latenciasMarcar(FASE_TURNO, &marcaNs);
+  }
+
+  // 2) CONSEGUIR UNA PLAZA
+  // ---------------------------------------------------
+  // La estrategia bloquea al auto hasta que tenga plaza (y registra si tuvo que esperar)
+  int estacionAsignada = estrategia->entrar(indiceAuto);
+  // Si lo echaron de la sala mientras esperaba, devuelve la plaza sin atenderse
+  if (llegadas.activas && !salaPasar(indiceAuto)) {
+    estrategia->salir(estacionAsignada);
+    return;
+  }
+  registrarEvento(EVENTO_INGRESO, indiceAuto, estacionAsignada, 0);
+
+  // Espera desde que llegó hasta que entró (solo se acumula con --politica)
+  uint64_t ingresoNs = relojNs();
+  metricasIngreso(estacionAsignada, ingresoNs - llegadaNs);
+  tableroIngreso(estacionAsignada, ingresoNs - llegadaNs);
+  prioridadesIngreso(indiceAuto, ingresoNs - llegadaNs);
+  latenciasMarcar(FASE_ESTACION, &marcaNs);
+
+  // 3) HACER LAS TAREAS DE MANTENIMIENTO (LAS DE SU PERFIL)
+  // ---------------------------------------------------
+  if (opciones.tecnicos) {
+    // Los técnicos de la estación hacen las tareas independientes a la vez (y anotan cada una)
+    tecnicosAtender(estacionAsignada, indiceAuto);
+    marcaNs = relojNs();
+  }
+  for (int i = 0; !opciones.tecnicos && i < escenario.nTareas; i++) {
+    if (!escenarioHaceTarea(&escenario, indiceAuto, i)) {
+      continue; // Su perfil no incluye esta tarea
+    }
+    registrarEvento(EVENTO_INICIO_TAREA, indiceAuto, estacionAsignada, i);
+    dormirNs(escenarioDuracionNs(&escenario, indiceAuto, i));
+    registrarEvento(EVENTO_FIN_TAREA, indiceAuto, estacionAsignada, i);
+    latenciasMarcar(FASE_PRIMERA_TAREA + i, &marcaNs);
+    if (opciones.medirFases) {
+      pestilloBajar(&fases[i]); // Uno menos para que todos hayan hecho esta tarea
+    }
+  }
+
+  // 4) TERMINÓ TODO, DEVOLVER LA PLAZA
+  // ---------------------------------------------------
+  registrarEvento(EVENTO_FIN_TODO, indiceAuto, estacionAsignada, 0);
+  metricasSalida(estacionAsignada, relojNs() - ingresoNs);
+  tableroSalida(estacionAsignada);
+  prioridadesSalida(indiceAuto, llegadaNs);
+  estrategia->salir(estacionAsignada);
+  if (llegadas.activas) {
+    salaSalir(indiceAuto);
+  }
+  latenciasMarcar(FASE_SALIDA, &marcaNs);
+}
+
+void imprimirFases(uint64_t inicioNs) {
+  for (int i = 0; i < escenario.nTareas; i++) {
+    if (autosPorFase[i] > 0) {
+      printf("Fase %s: los %d autos que la hacen la terminaron a los %.3f s\n", escenario.nombresTareas[i],
+             autosPorFase[i], (pestilloAbiertoNs(&fases[i]) - inicioNs) / 1e9);
+    }
+  }
+}
+
+void crearHilo(pthread_t* hilo, pthread_attr_t* atributos, void* (*rutina)(void*), void* arg) {
+  // Con --pestillo los hilos terminados liberan su lugar, así que si el sistema no deja
+  // crear más (EAGAIN) alcanza con esperar un poco a que termine alguno
+  while (pthread_create(hilo, atributos, rutina, arg) == EAGAIN && opciones.pestilloFinal) {
+    dormirNs(1000000);
+  }
+}
+
+void terminarHilo(void) {
+  if (opciones.pestilloFinal) {
+    pestilloBajar(&hilosTerminados); // Lo último que hace el hilo: después main puede seguir
+  } else if (estrategia->barreraAlFinal || programa.barreraAlFinal) {
+    pthread_barrier_wait(&barrera);
+  }
+}
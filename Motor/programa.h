@@ -0,0 +1,38 @@
+// QUÉ PROGRAMA ES EL MOTOR AL COMPILARLO
+//
+// Los programas de "Entrada Ordenada" y "Entrada Desordenada" no tienen un núcleo
+// propio: cada uno llena un Programa con su estrategia, su orden de entrada, sus
+// opciones y sus textos, y después incluye mantenimientoDeTeslasMotor.c. Así la
+// lógica de cada estrategia está escrita una sola vez (en Motor/estrategia*.h) y los
+// programas siguen compilándose solos con "gcc -pthread programa.c -lm".
+//
+// Un programa se arma así (con inicializadores designados, como las estrategias):
+//
+//   #define _XOPEN_SOURCE 600
+//   #include "../Comun/opciones.h" // Para OPCION_*
+//   #include "../Motor/programa.h"
+//   #define PROGRAMA_MOTOR
+//   static const Programa programa = {.estrategia = "espera", ...};
+//   #include "../Motor/mantenimientoDeTeslasMotor.c"
+//
+// Sin PROGRAMA_MOTOR el motor usa su propio Programa (todas las opciones del motor).
+
+#ifndef PROGRAMA_H
+#define PROGRAMA_H
+
+#include <stdint.h>            // Para uint64_t
+#include "../Comun/registro.h" // Para EVENTO_* y N_TIPOS_EVENTO
+
+typedef struct {
+  const char* estrategia;  // Estrategia sin --estrategia (--lockfree la cambia por "atomica"
+                           // y --combinar por "combinada")
+  int entradaOrdenada;     // 1 = los autos entran respetando su número (sin --entrada)
+  uint64_t duracionNs;     // Lo que dura cada tarea con el archivo de 3 números
+  int opciones;            // OPCION_* que acepta (ver Comun/opciones.h)
+  int barreraAlFinal;      // 1 = barrera al final con cualquier estrategia (variante Barrera)
+  int fibras;              // 1 = cada auto es una fibra (variante Fibras, ver autosFibra.h)
+  const char* formatos[N_TIPOS_EVENTO]; // Texto de cada EVENTO_* que cambia (NULL = el del motor)
+  const char* textoFinal;  // Línea del final (NULL = la del motor)
+} Programa;
+
+#endif
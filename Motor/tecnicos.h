@@ -0,0 +1,218 @@
+// TÉCNICOS POR ESTACIÓN: LAS TAREAS INDEPENDIENTES DE UN AUTO AL MISMO TIEMPO (--tecnicos)
+//
+// Sin técnicos el hilo del auto hace sus tareas una después de otra, aunque la
+// navegación no tenga nada que ver con la batería. Con --tecnicos N cada estación tiene
+// N técnicos (un hilo cada uno) y una fila de trabajos. Al entrar, el auto pone en la
+// fila de su estación las tareas que ya puede empezar y se duerme; cada técnico libre
+// saca un trabajo, hace la tarea y, al terminar, pone en la fila las tareas del mismo
+// auto que esperaban solo a esa (la directiva "depende" del escenario, ver escenario.h).
+// El técnico que termina la última tarea despierta al auto, que sale como siempre.
+//
+// Sin líneas "depende" todas las tareas son independientes: con tantos técnicos como
+// tareas, el auto tarda lo que su tarea más larga y no la suma de todas. Al final se
+// imprime el tiempo medio de servicio por auto (de que empieza su primera tarea hasta
+// que termina la última) contra la suma media de sus tareas.
+//
+// Un mutex por estación protege su fila y el estado de los autos que están en ella.
+
+#ifndef TECNICOS_H
+#define TECNICOS_H
+
+#include <pthread.h>             // Para los hilos de los técnicos, el mutex y las condiciones
+#include <stdatomic.h>           // Para los totales del resumen
+#include <stdint.h>              // Para uint32_t, uint64_t
+#include <stdio.h>               // Para printf
+#include <stdlib.h>              // Para malloc, calloc, free
+#include "../Comun/escenario.h"  // Para las tareas de cada auto, sus duraciones y "depende"
+#include "../Comun/registro.h"   // Para registrarEvento y relojNs
+#include "../Comun/latencias.h"  // Para anotar cuánto duró cada tarea (--latencias)
+#include "../Comun/afinidad.h"   // Para afinidadFijarHilo
+
+struct AutoEnTaller;
+
+// Una tarea de un auto lista para que la haga un técnico
+typedef struct TrabajoTecnico {
+  struct TrabajoTecnico* siguiente;
+  struct AutoEnTaller* dueno;
+  int tarea;
+} TrabajoTecnico;
+
+// Estado de un auto mientras le hacen sus tareas (vive en la pila de su hilo)
+typedef struct AutoEnTaller {
+  int indiceAuto, estacion;
+  uint32_t hechas;     // Bit i = la tarea i ya terminó (o el auto no la hace)
+  uint32_t lanzadas;   // Bit i = la tarea i ya se puso en la fila
+  pthread_cond_t listo;
+  TrabajoTecnico trabajos[MAX_TAREAS];
+} AutoEnTaller;
+
+typedef struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t hayTrabajo;
+  TrabajoTecnico *primero, *ultimo;
+  int cerrada;         // 1 = ya no llegan autos: los técnicos se van cuando se vacía la fila
+} FilaTecnicos;
+
+static struct {
+  const Escenario* escenario;
+  FilaTecnicos* filas; // filas[i] = la de la estación i+1
+  int nEstaciones, porEstacion;
+  pthread_t* hilos;
+  uint32_t todas;      // Máscara con todas las tareas del escenario
+  atomic_llong autos;
+  atomic_ullong servicioNs, tareasNs;
+} taller;
+
+// Pone en la fila las tareas del auto que ya tienen hechos sus requisitos (con el mutex)
+static void tecnicosLanzarListas(FilaTecnicos* f, AutoEnTaller* a) {
+  for (int i = 0; i < taller.escenario->nTareas; i++) {
+    uint32_t bit = 1u << i;
+    if ((a->hechas | a->lanzadas) & bit || (taller.escenario->requisitos[i] & ~a->hechas)) {
+      continue;
+    }
+    a->lanzadas |= bit;
+    TrabajoTecnico* t = &a->trabajos[i];
+    t->siguiente = NULL;
+    t->dueno = a;
+    t->tarea = i;
+    if (f->ultimo) {
+      f->ultimo->siguiente = t;
+    } else {
+      f->primero = t;
+    }
+    f->ultimo = t;
+    pthread_cond_signal(&f->hayTrabajo);
+  }
+}
+
+/* ---------------------------------------------------------
+Cada técnico ejecuta esta función: saca trabajos de la fila
+de su estación, hace la tarea y lanza las que dependían de
+ella, hasta que la fila está cerrada y vacía.
+------------------------------------------------------------*/
+static void* tecnicoRoutine(void* arg) {
+  FilaTecnicos* f = arg;
+  afinidadFijarHilo(); // Con --afinidad, al núcleo de una estación (en ronda)
+  pthread_mutex_lock(&f->mutex);
+  while (1) {
+    while (!f->primero && !f->cerrada) {
+      pthread_cond_wait(&f->hayTrabajo, &f->mutex);
+    }
+    TrabajoTecnico* t = f->primero;
+    if (!t) {
+      break; // Cerrada y sin trabajo
+    }
+    f->primero = t->siguiente;
+    if (!f->primero) {
+      f->ultimo = NULL;
+    }
+    pthread_mutex_unlock(&f->mutex);
+
+    AutoEnTaller* a = t->dueno;
+    registrarEvento(EVENTO_INICIO_TAREA, a->indiceAuto, a->estacion, t->tarea);
+    uint64_t inicioNs = relojNs(), marcaNs = inicioNs;
+    dormirNs(escenarioDuracionNs(taller.escenario, a->indiceAuto, t->tarea));
+    atomic_fetch_add_explicit(&taller.tareasNs, relojNs() - inicioNs, memory_order_relaxed);
+    registrarEvento(EVENTO_FIN_TAREA, a->indiceAuto, a->estacion, t->tarea);
+    latenciasMarcar(FASE_PRIMERA_TAREA + t->tarea, &marcaNs);
+
+    pthread_mutex_lock(&f->mutex);
+    a->hechas |= 1u << t->tarea;
+    if (a->hechas == taller.todas) {
+      pthread_cond_signal(&a->listo);
+    } else {
+      tecnicosLanzarListas(f, a);
+    }
+  }
+  pthread_mutex_unlock(&f->mutex);
+  return NULL;
+}
+
+// Crea "porEstacion" técnicos en cada estación. Devuelve -1 si no hay memoria o hilos.
+static int tecnicosIniciar(const Escenario* escenario, int porEstacion) {
+  taller.escenario = escenario;
+  taller.nEstaciones = escenario->nEstaciones;
+  taller.porEstacion = porEstacion;
+  taller.todas = escenario->nTareas == 32 ? ~0u : (1u << escenario->nTareas) - 1;
+  atomic_store(&taller.autos, 0);
+  atomic_store(&taller.servicioNs, 0);
+  atomic_store(&taller.tareasNs, 0);
+  taller.filas = calloc(taller.nEstaciones, sizeof(FilaTecnicos));
+  taller.hilos = malloc(sizeof(pthread_t) * (size_t)taller.nEstaciones * porEstacion);
+  if (!taller.filas || !taller.hilos) {
+    return -1;
+  }
+  for (int e = 0; e < taller.nEstaciones; e++) {
+    pthread_mutex_init(&taller.filas[e].mutex, NULL);
+    pthread_cond_init(&taller.filas[e].hayTrabajo, NULL);
+    for (int i = 0; i < porEstacion; i++) {
+      if (pthread_create(&taller.hilos[(size_t)e * porEstacion + i], NULL, tecnicoRoutine, &taller.filas[e]) != 0) {
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
+/* ---------------------------------------------------------
+El auto "indiceAuto", ya en "estacion" (1..n), pone en la fila
+las tareas de su perfil que puede empezar y duerme hasta que
+los técnicos terminan todas.
+------------------------------------------------------------*/
+static void tecnicosAtender(int estacion, int indiceAuto) {
+  AutoEnTaller a;
+  a.indiceAuto = indiceAuto;
+  a.estacion = estacion;
+  a.hechas = a.lanzadas = 0;
+  for (int i = 0; i < taller.escenario->nTareas; i++) {
+    if (!escenarioHaceTarea(taller.escenario, indiceAuto, i)) {
+      a.hechas |= 1u << i; // Su perfil no la incluye: cuenta como hecha para las que dependen de ella
+    }
+  }
+  if (a.hechas == taller.todas) {
+    return;
+  }
+  pthread_cond_init(&a.listo, NULL);
+  uint64_t inicioNs = relojNs();
+
+  FilaTecnicos* f = &taller.filas[estacion - 1];
+  pthread_mutex_lock(&f->mutex);
+  tecnicosLanzarListas(f, &a);
+  while (a.hechas != taller.todas) {
+    pthread_cond_wait(&a.listo, &f->mutex);
+  }
+  pthread_mutex_unlock(&f->mutex);
+
+  pthread_cond_destroy(&a.listo);
+  atomic_fetch_add_explicit(&taller.servicioNs, relojNs() - inicioNs, memory_order_relaxed);
+  atomic_fetch_add_explicit(&taller.autos, 1, memory_order_relaxed);
+}
+
+// Cierra las filas, espera a los técnicos e imprime el servicio medio por auto
+static void tecnicosTerminar(void) {
+  for (int e = 0; e < taller.nEstaciones; e++) {
+    pthread_mutex_lock(&taller.filas[e].mutex);
+    taller.filas[e].cerrada = 1;
+    pthread_cond_broadcast(&taller.filas[e].hayTrabajo);
+    pthread_mutex_unlock(&taller.filas[e].mutex);
+  }
+  for (size_t h = 0; h < (size_t)taller.nEstaciones * taller.porEstacion; h++) {
+    pthread_join(taller.hilos[h], NULL);
+  }
+  for (int e = 0; e < taller.nEstaciones; e++) {
+    pthread_mutex_destroy(&taller.filas[e].mutex);
+    pthread_cond_destroy(&taller.filas[e].hayTrabajo);
+  }
+
+  long long autos = atomic_load(&taller.autos);
+  if (autos > 0) {
+    double servicio = atomic_load(&taller.servicioNs) / 1e9 / autos;
+    double tareas = atomic_load(&taller.tareasNs) / 1e9 / autos;
+    printf("Técnicos: %d por estación, servicio medio por auto %.3f s (sus tareas suman %.3f s, %.2fx)\n",
+           taller.porEstacion, servicio, tareas, servicio > 0 ? tareas / servicio : 0.0);
+  }
+  free(taller.filas);
+  free(taller.hilos);
+}
+
+#endif